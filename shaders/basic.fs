@@ -16,6 +16,13 @@ uniform Material material;// 材质属性
 // 纹理采样器
 uniform sampler2D texture_diffuse1; 
 uniform bool useTexture; 
+// 体素合并面：纹理坐标超出图集中的单个图块，需要在图块内重复
+uniform bool atlasTiling;
+uniform vec4 atlasTile; // xy = 图块起点, zw = 图块尺寸
+// 纹理数组：同一组材质（如小屋）共用一个纹理，按层索引选择
+uniform sampler2DArray texture_array; // 纹理单元 1
+uniform bool useTextureArray;
+uniform float textureLayer;
 
 
 // 光源属性
@@ -26,7 +33,13 @@ uniform vec3 viewPos;
 void main() {
     
     vec3 diffuseColor;
-    if (useTexture) { 
+    if (useTexture && atlasTiling) {
+        // 用未折返的坐标求导，避免图块接缝处选错 mip 级别
+        vec2 tiled = atlasTile.xy + fract((TexCoord - atlasTile.xy) / atlasTile.zw) * atlasTile.zw;
+        diffuseColor = vec3(textureGrad(texture_diffuse1, tiled, dFdx(TexCoord), dFdy(TexCoord)));
+    } else if (useTexture && useTextureArray) {
+        diffuseColor = vec3(texture(texture_array, vec3(TexCoord, textureLayer)));
+    } else if (useTexture) { 
         diffuseColor = vec3(texture(texture_diffuse1, TexCoord)); // 从纹理中获取漫反射颜色
     } else {
         diffuseColor = material.diffuse; // 使用材质的漫反射颜色
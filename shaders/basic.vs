@@ -7,13 +7,36 @@ out vec3 Normal;
 out vec3 FragPos;
 out vec2 TexCoord; // ݸƬɫ
 
+//  depth.vs ʹͬλü㣬֤ԤȾ GL_LEQUAL λһ
+invariant gl_Position;
+
 uniform mat4 model;
 uniform mat4 view;
 uniform mat4 proj;
 
+// նʽλΪΧڵĹһ꣬Ϊ루aNormal.xy
+uniform bool compactVertex;
+uniform vec3 positionOffset;
+uniform vec3 positionScale;
+
+vec3 decodeOctahedral(vec2 e) {
+    vec3 n = vec3(e, 1.0 - abs(e.x) - abs(e.y));
+    float t = max(-n.z, 0.0);
+    n.x += (n.x >= 0.0) ? -t : t;
+    n.y += (n.y >= 0.0) ? -t : t;
+    return normalize(n);
+}
+
 void main() {
-    FragPos = vec3(model * vec4(aPos, 1.0));
-    Normal = mat3(transpose(inverse(model))) * aNormal;  
+    vec3 localPos = aPos;
+    vec3 localNormal = aNormal;
+    if (compactVertex) {
+        localPos = positionOffset + aPos * positionScale;
+        localNormal = decodeOctahedral(aNormal.xy);
+    }
+
+    FragPos = vec3(model * vec4(localPos, 1.0));
+    Normal = mat3(transpose(inverse(model))) * localNormal;  
     TexCoord = aTexCoord; //  
 
     gl_Position = proj * view * vec4(FragPos, 1.0);
@@ -0,0 +1,5 @@
+#version 330 core
+
+// 仅写入深度，颜色输出被 glColorMask 屏蔽
+void main() {
+}
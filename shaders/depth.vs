@@ -0,0 +1,24 @@
+#version 330 core
+layout (location = 0) in vec3 aPos; // 仅位置流
+
+uniform mat4 model;
+uniform mat4 view;
+uniform mat4 proj;
+
+// 紧凑顶点格式：位置为包围盒内的归一化坐标
+uniform bool compactVertex;
+uniform vec3 positionOffset;
+uniform vec3 positionScale;
+
+invariant gl_Position;
+
+void main() {
+    vec3 localPos = aPos;
+    if (compactVertex) {
+        localPos = positionOffset + aPos * positionScale;
+    }
+
+    // 与 basic.vs 的计算顺序保持一致
+    vec3 worldPos = vec3(model * vec4(localPos, 1.0));
+    gl_Position = proj * view * vec4(worldPos, 1.0);
+}
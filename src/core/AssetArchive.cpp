@@ -0,0 +1,269 @@
+#include "AssetArchive.h"
+#include "MeshCache.h"
+#include "ThreadPool.h"
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <system_error>
+
+#ifdef FOREST_LZ4
+#include <lz4.h>
+#endif
+#ifdef FOREST_ZSTD
+#include <zstd.h>
+#endif
+
+namespace fs = std::filesystem;
+
+namespace {
+
+const uint64_t kCompressedAlignment = 16; // 压缩条目解压到独立缓冲区，只需保证读取对齐
+
+uint64_t alignUp(uint64_t value, uint64_t alignment) {
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+// 已经是压缩格式的文件再压缩几乎没有收益，直接存储以便零拷贝映射
+bool isPrecompressed(const std::string& name) {
+    std::string extension = fs::path(name).extension().string();
+    return extension == ".jpg" || extension == ".jpeg" || extension == ".png";
+}
+
+bool compressEntry(ArchiveCompression compression, int level, const std::vector<uint8_t>& data,
+    std::vector<uint8_t>& out) {
+    switch (compression) {
+#ifdef FOREST_LZ4
+    case ArchiveCompression::LZ4: {
+        if (data.size() > (size_t)LZ4_MAX_INPUT_SIZE) return false;
+        out.resize((size_t)LZ4_compressBound((int)data.size()));
+        int size = LZ4_compress_fast((const char*)data.data(), (char*)out.data(), (int)data.size(),
+            (int)out.size(), std::max(level, 1));
+        if (size <= 0) return false;
+        out.resize((size_t)size);
+        return true;
+    }
+#endif
+#ifdef FOREST_ZSTD
+    case ArchiveCompression::Zstd: {
+        out.resize(ZSTD_compressBound(data.size()));
+        size_t size = ZSTD_compress(out.data(), out.size(), data.data(), data.size(), level);
+        if (ZSTD_isError(size)) return false;
+        out.resize(size);
+        return true;
+    }
+#endif
+    default:
+        (void)level; // 未启用任何编解码器时参数不被使用
+        (void)data;
+        (void)out;
+        return false;
+    }
+}
+
+bool readWholeFile(const std::string& path, std::vector<uint8_t>& data) {
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file) return false;
+    data.resize((size_t)file.tellg());
+    file.seekg(0);
+    return data.empty() || (bool)file.read((char*)data.data(), (std::streamsize)data.size());
+}
+
+// 打包前在线程池上读取并压缩的条目
+struct PreparedEntry {
+    std::string name;
+    std::vector<uint8_t> stored;
+    ArchiveEntry entry = {};
+    bool ok = false;
+};
+
+} // namespace
+
+std::string normalizeArchivePath(const std::string& path) {
+    std::string slashed = path;
+    std::replace(slashed.begin(), slashed.end(), '\\', '/');
+    std::string result = fs::path(slashed).lexically_normal().generic_string();
+    while (result.rfind("./", 0) == 0) result.erase(0, 2);
+    std::transform(result.begin(), result.end(), result.begin(),
+        [](unsigned char c) { return (char)std::tolower(c); });
+    return result;
+}
+
+const char* getArchiveCompressionName(ArchiveCompression compression) {
+    switch (compression) {
+    case ArchiveCompression::LZ4: return "lz4";
+    case ArchiveCompression::Zstd: return "zstd";
+    default: return "none";
+    }
+}
+
+bool isArchiveCompressionSupported(ArchiveCompression compression) {
+    switch (compression) {
+    case ArchiveCompression::None: return true;
+#ifdef FOREST_LZ4
+    case ArchiveCompression::LZ4: return true;
+#endif
+#ifdef FOREST_ZSTD
+    case ArchiveCompression::Zstd: return true;
+#endif
+    default: return false;
+    }
+}
+
+bool decompressArchiveEntry(ArchiveCompression compression, const uint8_t* data, size_t size,
+    uint8_t* out, size_t outSize) {
+    switch (compression) {
+    case ArchiveCompression::None:
+        if (size != outSize) return false;
+        std::memcpy(out, data, size);
+        return true;
+#ifdef FOREST_LZ4
+    case ArchiveCompression::LZ4:
+        if (size > (size_t)LZ4_MAX_INPUT_SIZE || outSize > (size_t)LZ4_MAX_INPUT_SIZE) return false;
+        return LZ4_decompress_safe((const char*)data, (char*)out, (int)size, (int)outSize) == (int)outSize;
+#endif
+#ifdef FOREST_ZSTD
+    case ArchiveCompression::Zstd: {
+        size_t result = ZSTD_decompress(out, outSize, data, size);
+        return !ZSTD_isError(result) && result == outSize;
+    }
+#endif
+    default:
+        return false;
+    }
+}
+
+bool writeAssetArchive(const std::string& path, const std::vector<ArchiveInput>& inputs,
+    const ArchiveWriteOptions& options, ArchiveWriteStats* stats) {
+    if (!isArchiveCompressionSupported(options.compression)) {
+        std::cerr << "[AssetArchive] Compression not available in this build: "
+            << getArchiveCompressionName(options.compression) << std::endl;
+        return false;
+    }
+    uint64_t alignment = std::max<uint64_t>(options.alignment, kCompressedAlignment);
+
+    // 按规范化路径排序（即索引顺序），重复路径只保留第一个
+    std::vector<PreparedEntry> prepared(inputs.size());
+    for (size_t i = 0; i < inputs.size(); i++) {
+        prepared[i].name = normalizeArchivePath(inputs[i].name);
+    }
+    std::vector<size_t> order(inputs.size());
+    for (size_t i = 0; i < order.size(); i++) order[i] = i;
+    std::stable_sort(order.begin(), order.end(),
+        [&](size_t a, size_t b) { return prepared[a].name < prepared[b].name; });
+
+    getThreadPool().parallelFor(inputs.size(), [&](size_t i) {
+        PreparedEntry& item = prepared[i];
+        std::vector<uint8_t> data;
+        MeshCacheSource source;
+        if (!readWholeFile(inputs[i].sourcePath, data) || !queryMeshCacheSource(inputs[i].sourcePath, source, true)) {
+            std::cerr << "[AssetArchive] Cannot read: " << inputs[i].sourcePath << std::endl;
+            return;
+        }
+        item.entry.size = data.size();
+        item.entry.mtime = source.mtime;
+        item.entry.hash = source.hash;
+        item.entry.compression = (uint32_t)ArchiveCompression::None;
+
+        std::vector<uint8_t> compressed;
+        if (options.compression != ArchiveCompression::None && !data.empty() && !isPrecompressed(item.name)
+            && compressEntry(options.compression, options.level, data, compressed)
+            && compressed.size() < data.size() * options.minRatio) {
+            item.entry.compression = (uint32_t)options.compression;
+            item.stored.swap(compressed);
+        } else {
+            item.stored.swap(data);
+        }
+        item.entry.storedSize = item.stored.size();
+        item.ok = true;
+    });
+
+    // 计算布局：数据区、索引、字符串表
+    std::vector<ArchiveEntry> index;
+    std::vector<const PreparedEntry*> written;
+    std::string strings;
+    uint64_t offset = alignUp(sizeof(ArchiveHeader), alignment);
+    for (size_t i : order) {
+        PreparedEntry& item = prepared[i];
+        if (!item.ok) return false;
+        if (!written.empty() && written.back()->name == item.name) {
+            std::cerr << "[AssetArchive] Duplicate path skipped: " << item.name << std::endl;
+            continue;
+        }
+        bool compressed = item.entry.compression != (uint32_t)ArchiveCompression::None;
+        offset = alignUp(offset, compressed ? kCompressedAlignment : alignment);
+        item.entry.offset = offset;
+        item.entry.nameOffset = (uint32_t)strings.size();
+        item.entry.nameLength = (uint32_t)item.name.size();
+        strings += item.name;
+        offset += item.entry.storedSize;
+        index.push_back(item.entry);
+        written.push_back(&item);
+    }
+
+    ArchiveHeader header = {};
+    header.magic = kArchiveMagic;
+    header.version = kArchiveVersion;
+    header.entryCount = (uint32_t)index.size();
+    header.alignment = (uint32_t)alignment;
+    header.indexOffset = alignUp(offset, 8);
+    header.stringsOffset = header.indexOffset + index.size() * sizeof(ArchiveEntry);
+    header.stringsSize = strings.size();
+
+    std::string tempPath = path + ".tmp";
+    {
+        std::ofstream out(tempPath, std::ios::binary | std::ios::trunc);
+        if (!out) {
+            std::cerr << "[AssetArchive] Cannot write archive: " << tempPath << std::endl;
+            return false;
+        }
+
+        uint64_t position = 0;
+        auto write = [&](const void* data, size_t bytes) {
+            out.write(static_cast<const char*>(data), (std::streamsize)bytes);
+            position += bytes;
+        };
+        auto padTo = [&](uint64_t target) {
+            static const char padding[4096] = {};
+            while (position < target) {
+                write(padding, (size_t)std::min<uint64_t>(sizeof(padding), target - position));
+            }
+        };
+
+        write(&header, sizeof(header));
+        for (size_t i = 0; i < written.size(); i++) {
+            padTo(index[i].offset);
+            write(written[i]->stored.data(), written[i]->stored.size());
+        }
+        padTo(header.indexOffset);
+        write(index.data(), index.size() * sizeof(ArchiveEntry));
+        write(strings.data(), strings.size());
+        if (!out) {
+            std::cerr << "[AssetArchive] Failed while writing archive: " << tempPath << std::endl;
+            out.close();
+            fs::remove(tempPath);
+            return false;
+        }
+    }
+
+    std::error_code ec;
+    fs::rename(tempPath, path, ec);
+    if (ec) {
+        std::cerr << "[AssetArchive] Cannot replace archive: " << path << " (" << ec.message() << ")" << std::endl;
+        fs::remove(tempPath, ec);
+        return false;
+    }
+
+    if (stats) {
+        *stats = ArchiveWriteStats();
+        stats->entries = index.size();
+        for (const ArchiveEntry& entry : index) {
+            if (entry.compression != (uint32_t)ArchiveCompression::None) stats->compressedEntries++;
+            stats->rawBytes += entry.size;
+        }
+        stats->archiveBytes = header.stringsOffset + header.stringsSize;
+    }
+    return true;
+}
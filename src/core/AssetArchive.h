@@ -0,0 +1,82 @@
+#ifndef ASSET_ARCHIVE_H
+#define ASSET_ARCHIVE_H
+
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+// 资源包（.sfpak）布局：
+// 文件头 | 条目数据（未压缩条目按 alignment 对齐，可直接映射使用）| 索引 | 路径字符串表
+// 索引按路径（小写、'/' 分隔、相对于打包根目录）升序排列，查找时二分
+// 条目可单独压缩（LZ4 / zstd，需构建时启用 FOREST_USE_LZ4 / FOREST_USE_ZSTD）
+
+const uint32_t kArchiveMagic = 0x4B504653; // "SFPK"
+const uint32_t kArchiveVersion = 1;
+
+enum class ArchiveCompression : uint32_t {
+    None = 0,
+    LZ4 = 1,
+    Zstd = 2
+};
+
+struct ArchiveHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t entryCount;
+    uint32_t alignment;
+    uint64_t indexOffset;
+    uint64_t stringsOffset;
+    uint64_t stringsSize;
+};
+
+struct ArchiveEntry {
+    uint64_t offset;      // 数据在包内的偏移
+    uint64_t storedSize;  // 包内大小（压缩后）
+    uint64_t size;        // 原始大小
+    int64_t mtime;        // 源文件修改时间（与 queryMeshCacheSource 一致）
+    uint64_t hash;        // 原始内容 FNV-1a 64
+    uint32_t nameOffset;  // 路径在字符串表中的偏移
+    uint32_t nameLength;
+    uint32_t compression; // ArchiveCompression
+    uint32_t reserved;
+};
+
+static_assert(sizeof(ArchiveHeader) == 40, "ArchiveHeader layout changed");
+static_assert(sizeof(ArchiveEntry) == 56, "ArchiveEntry layout changed");
+
+// 包内路径规范化：'\\' 转 '/'，去掉 . / ..，转小写
+std::string normalizeArchivePath(const std::string& path);
+
+const char* getArchiveCompressionName(ArchiveCompression compression);
+bool isArchiveCompressionSupported(ArchiveCompression compression);
+
+// 解压一个条目到 out（out 预先分配为原始大小）
+bool decompressArchiveEntry(ArchiveCompression compression, const uint8_t* data, size_t size,
+    uint8_t* out, size_t outSize);
+
+// 打包输入：包内路径 + 磁盘上的源文件
+struct ArchiveInput {
+    std::string name;
+    std::string sourcePath;
+};
+
+struct ArchiveWriteOptions {
+    ArchiveCompression compression = ArchiveCompression::None;
+    int level = 0;             // 压缩级别，0 为编解码器默认值
+    uint32_t alignment = 4096; // 未压缩条目的对齐（页大小，便于直接映射）
+    float minRatio = 0.9f;     // 压缩后不小于原始大小的此比例时按未压缩存储
+};
+
+struct ArchiveWriteStats {
+    size_t entries = 0;
+    size_t compressedEntries = 0;
+    uint64_t rawBytes = 0;
+    uint64_t archiveBytes = 0;
+};
+
+// 写入资源包（先写临时文件再替换）
+bool writeAssetArchive(const std::string& path, const std::vector<ArchiveInput>& inputs,
+    const ArchiveWriteOptions& options, ArchiveWriteStats* stats = nullptr);
+
+#endif // ASSET_ARCHIVE_H
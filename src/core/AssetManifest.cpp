@@ -0,0 +1,176 @@
+#include "AssetManifest.h"
+#include "AssetArchive.h"
+#include "VirtualFileSystem.h"
+#include "MeshCache.h"
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <mutex>
+#include <unordered_map>
+#include <cstdlib>
+#include <system_error>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+const char* kManifestHeader = "# SimpleForest asset manifest v1";
+
+struct ManifestState {
+    std::mutex mutex;
+    std::unordered_map<std::string, CookedAsset> assets; // 键为 normalizeArchivePath(源文件)
+};
+
+ManifestState& manifestState() {
+    static ManifestState state;
+    return state;
+}
+
+bool parseKind(const std::string& name, CookedAssetKind& kind) {
+    const CookedAssetKind kinds[] = { CookedAssetKind::Texture, CookedAssetKind::Mesh, CookedAssetKind::Shader };
+    for (CookedAssetKind candidate : kinds) {
+        if (name == getCookedAssetKindName(candidate)) {
+            kind = candidate;
+            return true;
+        }
+    }
+    return false;
+}
+
+std::vector<std::string> splitFields(const std::string& line, char separator) {
+    std::vector<std::string> fields;
+    std::string field;
+    std::istringstream ss(line);
+    while (std::getline(ss, field, separator)) {
+        fields.push_back(field);
+    }
+    return fields;
+}
+
+void hashCombine(uint64_t& hash, uint64_t value) {
+    hash ^= value + 0x9e3779b97f4a7c15ull + (hash << 6) + (hash >> 2);
+}
+
+} // namespace
+
+uint64_t computeCookedInputHash(const CookedAsset& asset) {
+    uint64_t hash = kCookerVersion;
+    hashCombine(hash, (uint64_t)asset.kind);
+    std::vector<std::string> inputs = asset.dependencies;
+    inputs.insert(inputs.begin(), asset.source);
+    for (const std::string& input : inputs) {
+        MeshCacheSource source;
+        hashCombine(hash, std::hash<std::string>()(input));
+        hashCombine(hash, queryMeshCacheSource(input, source, true) ? source.hash : 0);
+    }
+    return hash;
+}
+
+const char* getCookedAssetKindName(CookedAssetKind kind) {
+    switch (kind) {
+    case CookedAssetKind::Mesh: return "mesh";
+    case CookedAssetKind::Shader: return "shader";
+    default: return "texture";
+    }
+}
+
+bool readAssetManifest(const std::string& path, std::vector<CookedAsset>& assets) {
+    std::string text;
+    if (!readVirtualTextFile(path, text)) return false;
+
+    std::istringstream in(text);
+    std::string line;
+    size_t lineNumber = 0;
+    while (std::getline(in, line)) {
+        lineNumber++;
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        if (line.empty() || line[0] == '#') continue;
+
+        std::vector<std::string> fields = splitFields(line, '\t');
+        CookedAsset asset;
+        if (fields.size() < 4 || !parseKind(fields[0], asset.kind)) {
+            std::cerr << "[AssetManifest] Invalid line " << lineNumber << " in " << path << std::endl;
+            continue;
+        }
+        asset.source = fields[1];
+        asset.output = fields[2];
+        asset.inputHash = std::strtoull(fields[3].c_str(), nullptr, 16);
+        if (fields.size() > 4 && !fields[4].empty()) {
+            asset.dependencies = splitFields(fields[4], ';');
+        }
+        assets.push_back(asset);
+    }
+    return true;
+}
+
+bool writeAssetManifest(const std::string& path, const std::vector<CookedAsset>& assets) {
+    std::string tempPath = path + ".tmp";
+    {
+        std::ofstream out(tempPath, std::ios::trunc);
+        if (!out) {
+            std::cerr << "[AssetManifest] Cannot write manifest: " << tempPath << std::endl;
+            return false;
+        }
+        out << kManifestHeader << "\n";
+        for (const CookedAsset& asset : assets) {
+            out << getCookedAssetKindName(asset.kind) << '\t' << asset.source << '\t' << asset.output << '\t'
+                << std::hex << asset.inputHash << std::dec << '\t';
+            for (size_t i = 0; i < asset.dependencies.size(); i++) {
+                out << (i > 0 ? ";" : "") << asset.dependencies[i];
+            }
+            out << "\n";
+        }
+        if (!out) {
+            out.close();
+            fs::remove(tempPath);
+            return false;
+        }
+    }
+
+    std::error_code ec;
+    fs::rename(tempPath, path, ec);
+    if (ec) {
+        fs::remove(tempPath, ec);
+        return false;
+    }
+    return true;
+}
+
+bool loadAssetManifest(const std::string& path) {
+    std::vector<CookedAsset> assets;
+    if (!readAssetManifest(path, assets)) return false;
+
+    ManifestState& state = manifestState();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    state.assets.clear();
+    for (const CookedAsset& asset : assets) {
+        state.assets[normalizeArchivePath(asset.source)] = asset;
+    }
+    std::cout << "[AssetManifest] Loaded " << state.assets.size() << " cooked assets from " << path << std::endl;
+    return true;
+}
+
+size_t getCookedAssetCount() {
+    ManifestState& state = manifestState();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    return state.assets.size();
+}
+
+std::string getCookedAssetPath(const std::string& sourcePath) {
+    CookedAsset asset;
+    {
+        ManifestState& state = manifestState();
+        std::lock_guard<std::mutex> lock(state.mutex);
+        auto it = state.assets.find(normalizeArchivePath(sourcePath));
+        if (it == state.assets.end()) return sourcePath;
+        asset = it->second;
+    }
+    if (!virtualFileExists(asset.output)) return sourcePath;
+    // 源文件或依赖在烘焙之后被修改：产物已过期，使用源文件
+    if (computeCookedInputHash(asset) != asset.inputHash) {
+        std::cout << "[AssetManifest] " << asset.output << " is out of date, using " << sourcePath << std::endl;
+        return sourcePath;
+    }
+    return asset.output;
+}
@@ -0,0 +1,45 @@
+#ifndef ASSET_MANIFEST_H
+#define ASSET_MANIFEST_H
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+// 资源烘焙清单（asset_cook 生成，运行时启动时加载）
+// 文本格式，每行一个资源，字段以制表符分隔：
+//   类型  源文件  产物  输入哈希  依赖（以 ';' 分隔，可为空）
+// 输入哈希由源文件与所有依赖的内容哈希及烘焙器版本组合而成，不变时跳过重新烘焙
+
+enum class CookedAssetKind {
+    Texture, // <源>.dds：BC1/BC3 + 完整 mip 链
+    Mesh,    // <源>.meshcache：焊接、索引优化、meshlet 划分后的网格
+    Shader   // <源>.cooked：展开 #include、去掉注释后的 GLSL
+};
+
+struct CookedAsset {
+    CookedAssetKind kind = CookedAssetKind::Texture;
+    std::string source;
+    std::string output;
+    uint64_t inputHash = 0;
+    std::vector<std::string> dependencies;
+};
+
+const char* getCookedAssetKindName(CookedAssetKind kind);
+
+// 烘焙规则变化时递增，使所有产物重新烘焙
+const uint64_t kCookerVersion = 1;
+
+// 输入哈希：烘焙器版本 + 类型 + 源文件与各依赖的路径和内容哈希（缺失的依赖记为 0）
+uint64_t computeCookedInputHash(const CookedAsset& asset);
+
+bool readAssetManifest(const std::string& path, std::vector<CookedAsset>& assets);
+bool writeAssetManifest(const std::string& path, const std::vector<CookedAsset>& assets);
+
+// 运行时：加载清单（经虚拟文件系统，可位于资源包内）
+bool loadAssetManifest(const std::string& path);
+size_t getCookedAssetCount();
+
+// 源文件的烘焙产物路径；清单中没有、产物不存在或源文件 / 依赖已修改（输入哈希不符）时返回源路径
+std::string getCookedAssetPath(const std::string& sourcePath);
+
+#endif // ASSET_MANIFEST_H
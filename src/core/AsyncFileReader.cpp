@@ -0,0 +1,478 @@
+#include "AsyncFileReader.h"
+#include "AssetArchive.h"
+#include "VirtualFileSystem.h"
+#include "ThreadPool.h"
+#include <iostream>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <thread>
+#include <algorithm>
+#include <cstring>
+
+#ifdef __linux__
+#define FOREST_IO_URING 1
+#include <linux/io_uring.h>
+#include <sys/syscall.h>
+#include <sys/mman.h>
+#endif
+#ifndef _WIN32
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <cerrno>
+#endif
+
+namespace {
+
+struct ReadRequest {
+    FileReadResult result;
+    FileReadCallback callback;
+    std::string filePath;     // 实际读取的文件：散文件或资源包
+    bool wholeFile = true;    // 散文件：长度由 fstat 得到
+    uint64_t offset = 0;      // 资源包条目在包内的偏移
+    uint64_t length = 0;      // 要读取的字节数（包内为压缩后大小）
+    uint64_t size = 0;        // 解压后大小
+    uint32_t compression = 0; // ArchiveCompression
+    uint64_t done = 0;
+    int fd = -1;
+};
+
+ReadRequest* createRequest(const std::string& path, FileReadCallback callback) {
+    ReadRequest* request = new ReadRequest();
+    request->result.path = path;
+    request->callback = std::move(callback);
+    PackedFileLocation location;
+    if (locatePackedFile(path, location)) {
+        request->filePath = location.archivePath;
+        request->wholeFile = false;
+        request->offset = location.offset;
+        request->length = location.storedSize;
+        request->size = location.size;
+        request->compression = location.compression;
+    } else {
+        request->filePath = path;
+    }
+    return request;
+}
+
+// 在线程池上：解压资源包条目并调用回调
+void deliver(ReadRequest& request) {
+    FileReadResult& result = request.result;
+    ArchiveCompression compression = (ArchiveCompression)request.compression;
+    if (result.ok && compression != ArchiveCompression::None) {
+        std::vector<uint8_t> decompressed((size_t)request.size);
+        result.ok = decompressArchiveEntry(compression, result.data.data(), result.data.size(),
+            decompressed.data(), decompressed.size());
+        if (!result.ok) {
+            std::cerr << "[FileReader] Cannot decompress " << result.path << " ("
+                << getArchiveCompressionName(compression) << ")" << std::endl;
+        }
+        result.data.swap(decompressed);
+    }
+    if (!result.ok) result.data.clear();
+    request.callback(result);
+}
+
+void completeRequest(ReadRequest* request, bool ok) {
+#ifndef _WIN32
+    if (request->fd >= 0) {
+        ::close(request->fd);
+        request->fd = -1;
+    }
+#endif
+    request->result.ok = ok;
+    getThreadPool().submit([request]() {
+        std::unique_ptr<ReadRequest> owned(request);
+        deliver(*owned);
+    });
+}
+
+#ifndef _WIN32
+// 打开文件并确定读取长度（散文件 fstat，资源包条目已知）
+bool openRequest(ReadRequest& request) {
+    request.fd = ::open(request.filePath.c_str(), O_RDONLY | O_CLOEXEC);
+    if (request.fd < 0) return false;
+    if (request.wholeFile) {
+        struct stat st;
+        if (fstat(request.fd, &st) != 0) return false;
+        request.length = (uint64_t)st.st_size;
+    }
+    request.result.data.resize((size_t)request.length);
+    return true;
+}
+
+// 同步读取剩余部分（线程池后端，或内核不支持 IORING_OP_READ 时）
+bool readRemaining(ReadRequest& request) {
+    while (request.done < request.length) {
+        ssize_t bytes = pread(request.fd, request.result.data.data() + request.done,
+            (size_t)(request.length - request.done), (off_t)(request.offset + request.done));
+        if (bytes < 0 && errno == EINTR) continue;
+        if (bytes <= 0) return false;
+        request.done += (uint64_t)bytes;
+    }
+    return true;
+}
+
+bool readBlocking(ReadRequest& request) {
+    return (request.fd >= 0 || openRequest(request)) && readRemaining(request);
+}
+#else
+bool readBlocking(ReadRequest& request) {
+    std::ifstream file(request.filePath, std::ios::binary | std::ios::ate);
+    if (!file) return false;
+    if (request.wholeFile) request.length = (uint64_t)file.tellg();
+    request.result.data.resize((size_t)request.length);
+    file.seekg((std::streamoff)request.offset);
+    return request.length == 0
+        || (bool)file.read((char*)request.result.data.data(), (std::streamsize)request.length);
+}
+#endif
+
+#ifdef FOREST_IO_URING
+// 最小的 io_uring 封装：映射 SQ / CQ 环与 SQE 数组，只提交 IORING_OP_READ
+class IoUringRing {
+public:
+    ~IoUringRing() { close(); }
+
+    bool open(unsigned entries) {
+        io_uring_params params;
+        std::memset(&params, 0, sizeof(params));
+        ringFd = (int)syscall(__NR_io_uring_setup, entries, &params);
+        if (ringFd < 0) return false;
+
+        sqRingSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+        cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+        bool singleMap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+        if (singleMap) sqRingSize = cqRingSize = std::max(sqRingSize, cqRingSize);
+
+        sqRing = mmap(nullptr, sqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFd, IORING_OFF_SQ_RING);
+        if (sqRing == MAP_FAILED) { sqRing = nullptr; close(); return false; }
+        if (singleMap) {
+            cqRing = sqRing;
+        } else {
+            cqRing = mmap(nullptr, cqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFd, IORING_OFF_CQ_RING);
+            if (cqRing == MAP_FAILED) { cqRing = nullptr; close(); return false; }
+        }
+        sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+        void* sqeMemory = mmap(nullptr, sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFd, IORING_OFF_SQES);
+        if (sqeMemory == MAP_FAILED) { close(); return false; }
+        sqes = static_cast<io_uring_sqe*>(sqeMemory);
+
+        uint8_t* sq = static_cast<uint8_t*>(sqRing);
+        uint8_t* cq = static_cast<uint8_t*>(cqRing);
+        sqTail = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+        sqMask = reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+        sqArray = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+        cqHead = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+        cqTail = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+        cqMask = reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+        cqes = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+        sqEntries = params.sq_entries;
+        return true;
+    }
+
+    void close() {
+        if (sqes) munmap(sqes, sqesSize);
+        if (cqRing && cqRing != sqRing) munmap(cqRing, cqRingSize);
+        if (sqRing) munmap(sqRing, sqRingSize);
+        if (ringFd >= 0) ::close(ringFd);
+        sqes = nullptr;
+        sqRing = cqRing = nullptr;
+        ringFd = -1;
+    }
+
+    unsigned capacity() const { return sqEntries; }
+
+    // 调用方保证在途请求数不超过 capacity()，SQ 不会溢出
+    void queueRead(int fd, void* buffer, uint64_t length, uint64_t offset, void* userData) {
+        unsigned tail = *sqTail;
+        unsigned index = tail & *sqMask;
+        io_uring_sqe* sqe = &sqes[index];
+        std::memset(sqe, 0, sizeof(*sqe));
+        sqe->opcode = IORING_OP_READ;
+        sqe->fd = fd;
+        sqe->addr = (uint64_t)(uintptr_t)buffer;
+        sqe->len = (uint32_t)std::min<uint64_t>(length, 1u << 30);
+        sqe->off = offset;
+        sqe->user_data = (uint64_t)(uintptr_t)userData;
+        sqArray[index] = index;
+        __atomic_store_n(sqTail, tail + 1, __ATOMIC_RELEASE);
+        unsubmitted++;
+    }
+
+    // 提交所有排队的 SQE 并等待至少 minComplete 个完成；返回 false 表示环已不可用
+    bool submitAndWait(unsigned minComplete) {
+        int result = (int)syscall(__NR_io_uring_enter, ringFd, unsubmitted, minComplete,
+            minComplete > 0 ? IORING_ENTER_GETEVENTS : 0u, nullptr, 0);
+        if (result < 0) return errno == EINTR || errno == EAGAIN || errno == EBUSY;
+        unsubmitted -= std::min<unsigned>(unsubmitted, (unsigned)result);
+        return true;
+    }
+
+    template <typename Handler>
+    void reap(Handler handler) {
+        unsigned head = __atomic_load_n(cqHead, __ATOMIC_RELAXED);
+        unsigned tail = __atomic_load_n(cqTail, __ATOMIC_ACQUIRE);
+        while (head != tail) {
+            const io_uring_cqe& cqe = cqes[head & *cqMask];
+            handler((void*)(uintptr_t)cqe.user_data, cqe.res);
+            head++;
+        }
+        __atomic_store_n(cqHead, head, __ATOMIC_RELEASE);
+    }
+
+private:
+    int ringFd = -1;
+    void* sqRing = nullptr;
+    void* cqRing = nullptr;
+    size_t sqRingSize = 0;
+    size_t cqRingSize = 0;
+    size_t sqesSize = 0;
+    io_uring_sqe* sqes = nullptr;
+    unsigned* sqTail = nullptr;
+    unsigned* sqMask = nullptr;
+    unsigned* sqArray = nullptr;
+    unsigned* cqHead = nullptr;
+    unsigned* cqTail = nullptr;
+    unsigned* cqMask = nullptr;
+    io_uring_cqe* cqes = nullptr;
+    unsigned sqEntries = 0;
+    unsigned unsubmitted = 0;
+};
+
+const unsigned kRingEntries = 64; // 同时在途的读取数
+const unsigned kSubmitBatch = 4;  // 排队这么多个读取后先行提交
+#endif
+
+struct ReaderState {
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::deque<ReadRequest*> pending; // 等待 I/O 线程取走
+    std::thread thread;
+    bool stopping = false;
+    bool initialized = false;
+    FileReaderBackend backend = FileReaderBackend::ThreadPool;
+#ifdef FOREST_IO_URING
+    IoUringRing ring;
+    // io_uring_enter 失败时仍在途读取的原缓冲区：内核可能还会写入，保留到退出
+    std::vector<std::vector<uint8_t>> retiredBuffers;
+#endif
+
+    ~ReaderState();
+};
+
+void stopIoThread(ReaderState& state);
+
+// 在线程池上同步读取（线程池后端，或 io_uring 失败后接管剩余请求）
+void submitBlockingRead(ReadRequest* request) {
+    getThreadPool().submit([request]() {
+        std::unique_ptr<ReadRequest> owned(request);
+        owned->result.ok = readBlocking(*owned);
+#ifndef _WIN32
+        if (owned->fd >= 0) ::close(owned->fd);
+#endif
+        deliver(*owned);
+    });
+}
+
+// 先创建线程池：静态对象逆序析构，退出时 I/O 线程停止（交付剩余完成）后线程池才析构
+ReaderState& readerState() {
+    getThreadPool();
+    static ReaderState state;
+    return state;
+}
+
+#ifdef FOREST_IO_URING
+// I/O 线程：取出新请求、打开文件、填满 SQ，一次 io_uring_enter 提交并等待完成；
+// 短读与 EINTR 重新排队，内核不支持 IORING_OP_READ 时改为同步读取；
+// io_uring_enter 失败时剩余请求全部交给线程池同步读取，之后的批次也改走线程池后端
+void ioThreadLoop() {
+    ReaderState& state = readerState();
+    std::deque<ReadRequest*> waiting;
+    std::vector<ReadRequest*> inFlight;
+    auto handleCompletion = [&](void* userData, int result) {
+        ReadRequest* request = static_cast<ReadRequest*>(userData);
+        auto it = std::find(inFlight.begin(), inFlight.end(), request);
+        if (it != inFlight.end()) {
+            *it = inFlight.back();
+            inFlight.pop_back();
+        }
+        if (result == -EINTR || result == -EAGAIN) {
+            waiting.push_front(request);
+        } else if (result == -EINVAL || result == -EOPNOTSUPP) {
+            completeRequest(request, readRemaining(*request));
+        } else if (result <= 0) {
+            completeRequest(request, false);
+        } else {
+            request->done += (uint64_t)result;
+            if (request->done < request->length) waiting.push_front(request);
+            else completeRequest(request, true);
+        }
+    };
+
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(state.mutex);
+            if (inFlight.empty() && waiting.empty()) {
+                state.wake.wait(lock, [&]() { return state.stopping || !state.pending.empty(); });
+                if (state.pending.empty()) break;
+            }
+            waiting.insert(waiting.end(), state.pending.begin(), state.pending.end());
+            state.pending.clear();
+        }
+
+        // 打开文件与分配缓冲区也在本线程上，每凑满 kSubmitBatch 个读取先提交一次，
+        // 使前面的读取与后续文件的打开重叠，并尽早交付已完成的读取（降低尾延迟）
+        unsigned queued = 0;
+        while (!waiting.empty() && inFlight.size() < state.ring.capacity()) {
+            ReadRequest* request = waiting.front();
+            waiting.pop_front();
+            if (request->fd < 0 && !openRequest(*request)) {
+                completeRequest(request, false);
+            } else if (request->done >= request->length) {
+                completeRequest(request, true);
+            } else {
+                state.ring.queueRead(request->fd, request->result.data.data() + request->done,
+                    request->length - request->done, request->offset + request->done, request);
+                inFlight.push_back(request);
+                if (++queued == kSubmitBatch) {
+                    queued = 0;
+                    if (state.ring.submitAndWait(0)) state.ring.reap(handleCompletion);
+                }
+            }
+        }
+        if (inFlight.empty()) continue;
+
+        if (!state.ring.submitAndWait(1)) {
+            std::cerr << "[FileReader] io_uring_enter failed (" << std::strerror(errno) << "), "
+                << inFlight.size() + waiting.size() << " reads moved to thread pool reads" << std::endl;
+            state.ring.reap(handleCompletion); // 已完成的照常交付
+            {
+                std::lock_guard<std::mutex> lock(state.mutex);
+                state.backend = FileReaderBackend::ThreadPool;
+                waiting.insert(waiting.end(), state.pending.begin(), state.pending.end());
+                state.pending.clear();
+                // 仍在途的读取换用新缓冲区从头读取
+                for (ReadRequest* request : inFlight) {
+                    state.retiredBuffers.push_back(std::move(request->result.data));
+                    request->result.data = std::vector<uint8_t>((size_t)request->length);
+                    request->done = 0;
+                    waiting.push_back(request);
+                }
+            }
+            inFlight.clear();
+            for (ReadRequest* request : waiting) {
+                submitBlockingRead(request);
+            }
+            waiting.clear();
+            break;
+        }
+        state.ring.reap(handleCompletion);
+    }
+}
+#endif
+
+// 首次使用时选择后端：优先 io_uring
+void ensureInitialized(ReaderState& state) {
+    if (state.initialized) return;
+    state.initialized = true;
+#ifdef FOREST_IO_URING
+    if (state.ring.open(kRingEntries)) {
+        state.backend = FileReaderBackend::IoUring;
+        state.stopping = false;
+        state.thread = std::thread(ioThreadLoop);
+        return;
+    }
+    std::cout << "[FileReader] io_uring unavailable (" << std::strerror(errno) << "), using thread pool reads" << std::endl;
+#endif
+    state.backend = FileReaderBackend::ThreadPool;
+}
+
+void stopIoThread(ReaderState& state) {
+    {
+        std::lock_guard<std::mutex> lock(state.mutex);
+        state.stopping = true;
+    }
+    state.wake.notify_all();
+    if (state.thread.joinable()) state.thread.join();
+    std::lock_guard<std::mutex> lock(state.mutex);
+#ifdef FOREST_IO_URING
+    state.ring.close();
+#endif
+    state.stopping = false;
+    state.initialized = false;
+}
+
+ReaderState::~ReaderState() {
+    stopIoThread(*this);
+}
+
+void enqueue(const std::vector<ReadRequest*>& requests) {
+    ReaderState& state = readerState();
+    bool useRing;
+    {
+        std::lock_guard<std::mutex> lock(state.mutex);
+        ensureInitialized(state);
+        useRing = state.backend == FileReaderBackend::IoUring;
+        if (useRing) state.pending.insert(state.pending.end(), requests.begin(), requests.end());
+    }
+    if (useRing) {
+        state.wake.notify_one();
+        return;
+    }
+    for (ReadRequest* request : requests) {
+        submitBlockingRead(request);
+    }
+}
+
+} // namespace
+
+void readFileAsync(const std::string& path, FileReadCallback callback) {
+    enqueue({ createRequest(path, std::move(callback)) });
+}
+
+void readFilesAsync(const std::vector<std::string>& paths, const FileReadCallback& callback) {
+    std::vector<ReadRequest*> requests;
+    for (size_t i = 0; i < paths.size(); i++) {
+        requests.push_back(createRequest(paths[i], callback));
+        requests.back()->result.index = i;
+    }
+    enqueue(requests);
+}
+
+bool setFileReaderBackend(FileReaderBackend backend) {
+    ReaderState& state = readerState();
+    {
+        std::lock_guard<std::mutex> lock(state.mutex);
+        ensureInitialized(state);
+        if (state.backend == backend) return true;
+    }
+    stopIoThread(state);
+
+    std::lock_guard<std::mutex> lock(state.mutex);
+    if (backend == FileReaderBackend::ThreadPool) {
+        state.initialized = true;
+        state.backend = FileReaderBackend::ThreadPool;
+        return true;
+    }
+    ensureInitialized(state);
+    return state.backend == FileReaderBackend::IoUring;
+}
+
+FileReaderBackend getFileReaderBackend() {
+    ReaderState& state = readerState();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    ensureInitialized(state);
+    return state.backend;
+}
+
+const char* getFileReaderBackendName() {
+    return getFileReaderBackend() == FileReaderBackend::IoUring ? "io_uring" : "thread pool pread";
+}
+
+void shutdownFileReader() {
+    stopIoThread(readerState());
+}
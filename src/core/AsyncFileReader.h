@@ -0,0 +1,42 @@
+#ifndef ASYNC_FILE_READER_H
+#define ASYNC_FILE_READER_H
+
+#include <functional>
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+// 异步文件读取：Linux 上使用 io_uring（直接系统调用，不依赖 liburing），由一个 I/O 线程批量提交、收割；
+// io_uring 不可用（旧内核、容器禁用、非 Linux）时退回线程池上的 pread。
+// 已挂载资源包内的条目按偏移从包文件读取，压缩条目在完成后解压；其余为散文件整文件读取。
+// 完成回调在共享线程池上执行，可以直接在回调中解码，不再占用工作线程等待磁盘
+
+enum class FileReaderBackend {
+    IoUring,
+    ThreadPool
+};
+
+struct FileReadResult {
+    std::string path;
+    size_t index = 0; // 在 readFilesAsync 批次中的序号
+    std::vector<uint8_t> data;
+    bool ok = false;
+};
+
+using FileReadCallback = std::function<void(FileReadResult&)>;
+
+void readFileAsync(const std::string& path, FileReadCallback callback);
+
+// 一批读取一次提交（io_uring 下合并为一次 io_uring_enter）；每个文件完成时各自回调
+void readFilesAsync(const std::vector<std::string>& paths, const FileReadCallback& callback);
+
+// 切换后端（基准测试用）；io_uring 不可用时返回 false 并保持线程池后端
+bool setFileReaderBackend(FileReaderBackend backend);
+FileReaderBackend getFileReaderBackend();
+const char* getFileReaderBackendName();
+
+// 等待所有已提交的读取完成并停止 I/O 线程（回调可能仍在线程池上执行）
+void shutdownFileReader();
+
+#endif // ASYNC_FILE_READER_H
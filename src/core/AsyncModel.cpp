@@ -0,0 +1,57 @@
+#include "AsyncModel.h"
+#include "ThreadPool.h"
+#include <iostream>
+#include <atomic>
+#include <chrono>
+#include <exception>
+
+struct ModelLoadJob {
+    std::string path;
+    std::unique_ptr<Model> model;
+    std::atomic<bool> prepared{ false }; // 工作线程完成 CPU 阶段（成功或失败）
+    ModelLoadStatus status = ModelLoadStatus::Loading; // 只在主线程读写
+    std::chrono::steady_clock::time_point start;
+};
+
+ModelLoadHandle loadModelAsync(const std::string& path, const ModelImportOptions& options) {
+    auto job = std::make_shared<ModelLoadJob>();
+    job->path = path;
+    job->start = std::chrono::steady_clock::now();
+    getThreadPool().submit([job, options]() {
+        try {
+            job->model = Model::prepare(job->path, options);
+        } catch (const std::exception& e) {
+            std::cerr << "[Model] Exception while loading " << job->path << ": " << e.what() << std::endl;
+            job->model.reset();
+        } catch (...) {
+            std::cerr << "[Model] Unknown exception while loading " << job->path << std::endl;
+            job->model.reset();
+        }
+        job->prepared = true;
+    });
+    return job;
+}
+
+ModelLoadStatus pollModelLoad(const ModelLoadHandle& load) {
+    if (!load) return ModelLoadStatus::Failed;
+    if (load->status != ModelLoadStatus::Loading || !load->prepared) return load->status;
+
+    if (load->model) {
+        load->model->uploadPrepared();
+    }
+    if (!load->model || load->model->meshes.empty()) {
+        load->model.reset();
+        load->status = ModelLoadStatus::Failed;
+        return load->status;
+    }
+
+    double elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - load->start).count();
+    std::cout << "[Model] Async load of " << load->path << " ready after " << elapsed << " ms" << std::endl;
+    load->status = ModelLoadStatus::Ready;
+    return load->status;
+}
+
+std::unique_ptr<Model> takeLoadedModel(const ModelLoadHandle& load) {
+    if (!load || load->status != ModelLoadStatus::Ready) return nullptr;
+    return std::move(load->model);
+}
@@ -0,0 +1,27 @@
+#ifndef ASYNC_MODEL_H
+#define ASYNC_MODEL_H
+
+#include "Model.h"
+#include <memory>
+#include <string>
+
+// 异步模型加载：文件读取、导入与 CPU 处理（或映射 .meshcache）在线程池上执行，
+// CPU 阶段完成后由主线程在 pollModelLoad 中创建网格缓冲并请求纹理。加载期间调用方继续渲染占位几何
+enum class ModelLoadStatus {
+    Loading,
+    Ready,
+    Failed
+};
+
+struct ModelLoadJob;
+using ModelLoadHandle = std::shared_ptr<ModelLoadJob>;
+
+ModelLoadHandle loadModelAsync(const std::string& path, const ModelImportOptions& options = ModelImportOptions());
+
+// 主线程每帧调用：CPU 阶段完成后在此执行 GPU 上传（只执行一次）
+ModelLoadStatus pollModelLoad(const ModelLoadHandle& load);
+
+// Ready 之后取出模型（只能取一次）；没有网格的模型视为加载失败
+std::unique_ptr<Model> takeLoadedModel(const ModelLoadHandle& load);
+
+#endif // ASYNC_MODEL_H
@@ -0,0 +1,615 @@
+#include "AsyncTexture.h"
+#include "ThreadPool.h"
+#include "TextureCooker.h"
+#include "MipGenerator.h"
+#include "ImageDecoder.h"
+#include "AsyncFileReader.h"
+#include "Texture.h"
+#include <iostream>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <deque>
+#include <unordered_map>
+#include <chrono>
+#include <thread>
+#include <cstring>
+#include <algorithm>
+#include <cstdint>
+
+namespace {
+
+struct DecodedImage {
+    int width = 0;
+    int height = 0;
+    int channels = 0;
+    unsigned char* pixels = nullptr;
+    std::vector<std::vector<unsigned char>> mips; // 第 1 级起的 mip 链（工作线程生成）
+    std::vector<unsigned char> layer; // 纹理数组层：统一为 RGBA 与层尺寸后的图像
+};
+
+struct TextureJob {
+    GLuint texture = 0;
+    GLenum target = GL_TEXTURE_2D;
+    std::vector<std::string> paths;
+    std::vector<DecodedImage> images;
+    std::vector<CompressedImage> compressed; // 启用纹理压缩时由烘焙缓存填充
+    bool compress = false;
+    bool mipmaps = true;
+    int maxLayerSize = 0; // 纹理数组的层尺寸上限
+    int qualityShift = 0; // 纹理质量档位：解码时缩小 / 跳过的顶层 mip 级数
+    std::atomic<int> remaining{ 0 };
+    bool canceled = false; // 纹理在上传前已被删除（受 LoaderState::mutex 保护）
+
+    // 渐进上传状态（主线程）
+    bool started = false;
+    bool useCompressed = false;
+    int nextLevel = -1;     // 下一个要上传的 mip 级别，低于 stopLevel 表示全部完成
+    int stopLevel = 0;      // 上传到的最高分辨率级别
+    int resumeLevel = -1;   // 恢复任务：开始时已驻留的 BASE_LEVEL
+    float priority = 0.0f;  // 屏幕尺寸（像素），越大越先上传
+    uint64_t priorityFrame = 0;
+};
+
+struct LoaderState {
+    std::mutex mutex;
+    std::deque<std::shared_ptr<TextureJob>> ready; // 解码完成、等待上传
+    std::unordered_map<GLuint, std::shared_ptr<TextureJob>> inFlight; // 已提交但尚未上传
+    GLuint pixelBuffer = 0;
+    bool compressionEnabled = true;
+    uint64_t frame = 0; // processTextureUploads 调用次数，屏幕尺寸按帧刷新
+};
+
+const int kStreamingBaseSize = 64; // 首次上传的最大 mip 尺寸
+
+LoaderState& loaderState() {
+    static LoaderState state;
+    return state;
+}
+
+GLenum formatForChannels(int channels) {
+    if (channels == 1) return GL_RED;
+    if (channels == 2) return GL_RG;
+    if (channels == 3) return GL_RGB;
+    return GL_RGBA;
+}
+
+// 1x1 中灰占位纹理，保证纹理在解码完成前即可采样
+void createPlaceholder(GLuint texture, GLenum target, size_t layers = 1) {
+    const unsigned char texel[4] = { 128, 128, 128, 255 };
+    glBindTexture(target, texture);
+    if (target == GL_TEXTURE_CUBE_MAP) {
+        for (unsigned int i = 0; i < 6; i++) {
+            glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, 0, GL_RGBA, 1, 1, 0, GL_RGBA, GL_UNSIGNED_BYTE, texel);
+        }
+    } else if (target == GL_TEXTURE_2D_ARRAY) {
+        std::vector<unsigned char> texels(layers * 4);
+        for (size_t i = 0; i < texels.size(); i++) texels[i] = texel[i % 4];
+        glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, GL_RGBA, 1, 1, (GLsizei)layers, 0, GL_RGBA, GL_UNSIGNED_BYTE, texels.data());
+    } else {
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, 1, 1, 0, GL_RGBA, GL_UNSIGNED_BYTE, texel);
+    }
+}
+
+// 纹理数组的各层解码完成后（在最后一个解码任务中）：
+// 层尺寸取各层最大边长（不超过 maxLayerSize），尺寸不同的层重采样，缺失的层填充中灰，再生成 mip 链
+void prepareArrayLayers(TextureJob& job) {
+    int size = 1;
+    for (const DecodedImage& image : job.images) {
+        if (image.pixels) size = std::max(size, std::max(image.width, image.height));
+    }
+    if (job.maxLayerSize > 0) size = std::min(size, job.maxLayerSize);
+
+    getThreadPool().parallelFor(job.images.size(), [&](size_t i) {
+        DecodedImage& image = job.images[i];
+        if (!image.pixels) {
+            std::cerr << "Texture array layer failed to load at path: " << job.paths[i] << std::endl;
+            image.layer.assign((size_t)size * size * 4, 128);
+        } else if (image.width != size || image.height != size) {
+            resizeImage(image.pixels, image.width, image.height, 4, true, image.layer, size, size);
+        } else {
+            image.layer.assign(image.pixels, image.pixels + (size_t)size * size * 4);
+        }
+        freeImage(image.pixels);
+        image.pixels = nullptr;
+        image.width = size;
+        image.height = size;
+        image.channels = 4;
+        if (job.mipmaps) {
+            generateMipChain(image.layer.data(), size, size, 4, true, image.mips);
+        }
+    });
+}
+
+// 解码第 i 个源图像（按质量档位缩小）并生成 mip 链
+void decodeImage(TextureJob& job, size_t i) {
+    DecodedImage& image = job.images[i];
+    image.pixels = loadImage(job.paths[i].c_str(), &image.width, &image.height, &image.channels, 0, job.qualityShift);
+    if (image.pixels && job.mipmaps) {
+        generateMipChain(image.pixels, image.width, image.height, image.channels, true, image.mips);
+    }
+}
+
+// 烘焙缓存为全尺寸：按质量档位丢弃顶层 mip（至少保留最后一级）
+void skipTopLevels(CompressedImage& image, int count) {
+    count = std::min(count, (int)image.levels.size() - 1);
+    if (count <= 0) return;
+    image.levels.erase(image.levels.begin(), image.levels.begin() + count);
+    image.width = std::max(1, image.width >> count);
+    image.height = std::max(1, image.height >> count);
+}
+
+// 从异步读取的文件数据解码第 i 个源图像；纹理数组统一解码为 RGBA，mip 链在统一层尺寸后生成
+void decodeImageData(TextureJob& job, size_t i, const FileReadResult& file) {
+    DecodedImage& image = job.images[i];
+    bool arrayLayer = (job.target == GL_TEXTURE_2D_ARRAY);
+    if (file.ok) {
+        image.pixels = loadImageFromMemory(file.data.data(), file.data.size(), &image.width, &image.height,
+            &image.channels, arrayLayer ? 4 : 0, job.qualityShift);
+    }
+    if (image.pixels && job.mipmaps && !arrayLayer) {
+        generateMipChain(image.pixels, image.width, image.height, image.channels, true, image.mips);
+    }
+}
+
+// 最后一个完成的解码任务把整个纹理放入上传队列（纹理数组先统一各层）
+void finishImage(const std::shared_ptr<TextureJob>& job) {
+    if (--job->remaining != 0) return;
+    if (job->target == GL_TEXTURE_2D_ARRAY) prepareArrayLayers(*job);
+    LoaderState& state = loaderState();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    state.ready.push_back(job);
+}
+
+void submitJob(const std::shared_ptr<TextureJob>& job) {
+    LoaderState& state = loaderState();
+    {
+        std::lock_guard<std::mutex> lock(state.mutex);
+        state.inFlight[job->texture] = job;
+    }
+
+    job->images.resize(job->paths.size());
+    job->compressed.resize(job->compress ? job->paths.size() : 0);
+    job->remaining = (int)job->paths.size();
+
+    // 压缩路径：读取（映射）或生成 .dds 烘焙缓存；源图像无法解码时交给未压缩路径报错
+    if (job->compress) {
+        for (size_t i = 0; i < job->paths.size(); i++) {
+            getThreadPool().submit([job, i]() {
+                if (!cookTexture(job->paths[i], job->mipmaps, job->compressed[i])) {
+                    decodeImage(*job, i);
+                } else {
+                    skipTopLevels(job->compressed[i], job->qualityShift);
+                }
+                finishImage(job);
+            });
+        }
+        return;
+    }
+
+    // 未压缩路径：各面 / 层一次批量提交给异步读取器，读取完成的回调直接在线程池上解码，
+    // 工作线程不再阻塞在磁盘读取上
+    readFilesAsync(job->paths, [job](FileReadResult& file) {
+        decodeImageData(*job, file.index, file);
+        finishImage(job);
+    });
+}
+
+// 孤立旧存储后映射写入，驱动可在 GPU 仍读取上一张图像时分配新缓冲
+bool fillPixelBuffer(const void* data, size_t size) {
+    glBufferData(GL_PIXEL_UNPACK_BUFFER, (GLsizeiptr)size, nullptr, GL_STREAM_DRAW);
+    void* dst = glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, (GLsizeiptr)size,
+        GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+    if (!dst) return false;
+    std::memcpy(dst, data, size);
+    return glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER) == GL_TRUE;
+}
+
+// 所有面都已烘焙且格式一致时走压缩上传；否则补齐缺失的未压缩图像
+bool prepareCompressed(TextureJob& job) {
+    if (job.compressed.empty()) return false;
+    bool usable = true;
+    for (const CompressedImage& image : job.compressed) {
+        if (image.levels.empty() || image.format != job.compressed[0].format) usable = false;
+    }
+    if (usable) return true;
+
+    for (size_t i = 0; i < job.compressed.size(); i++) {
+        if (!job.compressed[i].levels.empty() && !job.images[i].pixels) {
+            decodeImage(job, i);
+        }
+    }
+    job.compressed.clear();
+    return false;
+}
+
+void releaseJob(TextureJob& job) {
+    for (DecodedImage& image : job.images) {
+        freeImage(image.pixels);
+        image.pixels = nullptr;
+        image.mips.clear();
+        image.layer.clear();
+    }
+    job.compressed.clear();
+}
+
+void beginUpload(TextureJob& job) {
+    LoaderState& state = loaderState();
+    if (state.pixelBuffer == 0) {
+        glGenBuffers(1, &state.pixelBuffer);
+    }
+    glBindTexture(job.target, job.texture);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, state.pixelBuffer);
+}
+
+void endUpload() {
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+}
+
+// 逐级分配整个数组后按层拷贝（每层每级一次 PBO 填充）
+void uploadArrayJob(TextureJob& job) {
+    beginUpload(job);
+
+    int size = job.images[0].width;
+    size_t levels = job.images[0].mips.size() + 1;
+    GLsizei layers = (GLsizei)job.images.size();
+    int levelSize = size;
+    for (size_t level = 0; level < levels; level++) {
+        glTexImage3D(GL_TEXTURE_2D_ARRAY, (GLint)level, GL_RGBA, levelSize, levelSize, layers, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+        for (GLsizei layer = 0; layer < layers; layer++) {
+            const DecodedImage& image = job.images[layer];
+            const unsigned char* data = (level == 0) ? image.layer.data() : image.mips[level - 1].data();
+            if (fillPixelBuffer(data, (size_t)levelSize * levelSize * 4)) {
+                glTexSubImage3D(GL_TEXTURE_2D_ARRAY, (GLint)level, 0, 0, layer, levelSize, levelSize, 1,
+                    GL_RGBA, GL_UNSIGNED_BYTE, (void*)0);
+            }
+        }
+        levelSize = std::max(1, levelSize / 2);
+    }
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAX_LEVEL, (GLint)levels - 1);
+    endUpload();
+    std::cout << "Texture array loaded successfully: " << layers << " layers, " << size << "x" << size << std::endl;
+
+    releaseJob(job);
+}
+
+// 上传一个面的一个 mip 级别（调用前已绑定纹理与 PBO）
+void uploadLevel(const TextureJob& job, size_t face, GLenum faceTarget, int level) {
+    if (job.useCompressed) {
+        const CompressedImage& image = job.compressed[face];
+        const std::vector<uint8_t>& data = image.levels[level];
+        int width = std::max(1, image.width >> level);
+        int height = std::max(1, image.height >> level);
+        if (fillPixelBuffer(data.data(), data.size())) {
+            glCompressedTexImage2D(faceTarget, level, compressedInternalFormat(image.format), width, height, 0, (GLsizei)data.size(), (void*)0);
+        }
+        return;
+    }
+
+    // 第 0 级与预生成的 mip 链都只是拷贝，不依赖驱动的 glGenerateMipmap
+    const DecodedImage& image = job.images[face];
+    GLenum format = formatForChannels(image.channels);
+    int width = std::max(1, image.width >> level);
+    int height = std::max(1, image.height >> level);
+    const unsigned char* data = (level == 0) ? image.pixels : image.mips[level - 1].data();
+    if (fillPixelBuffer(data, (size_t)width * height * image.channels)) {
+        glTexImage2D(faceTarget, level, format, width, height, 0, format, GL_UNSIGNED_BYTE, (void*)0);
+    }
+}
+
+int jobLevelCount(const TextureJob& job) {
+    return job.useCompressed ? (int)job.compressed[0].levels.size() : (int)job.images[0].mips.size() + 1;
+}
+
+// 首次上传前：选择压缩 / 未压缩数据并检查解码结果，失败时返回 false
+bool validateJob(TextureJob& job) {
+    job.useCompressed = prepareCompressed(job);
+    bool complete = true;
+    for (size_t i = 0; i < job.images.size() && !job.useCompressed; i++) {
+        if (!job.images[i].pixels) {
+            const char* kind = (job.target == GL_TEXTURE_CUBE_MAP) ? "Cubemap texture" : "Texture";
+            std::cerr << kind << " failed to load at path: " << job.paths[i] << std::endl;
+            complete = false;
+        }
+    }
+    return complete;
+}
+
+// 立方体贴图：六个面的第 0 级一次上传
+void uploadCubemapJob(TextureJob& job) {
+    if (validateJob(job)) {
+        beginUpload(job);
+        for (size_t i = 0; i < job.paths.size(); i++) {
+            uploadLevel(job, i, GL_TEXTURE_CUBE_MAP_POSITIVE_X + (GLenum)i, 0);
+        }
+        endUpload();
+    }
+    releaseJob(job);
+}
+
+// 恢复任务：已驻留级别与新解码的数据格式、尺寸一致时才能只补上层 mip
+bool residentLevelsMatch(const TextureJob& job) {
+    int level = job.resumeLevel;
+    GLint width = 0, compressed = 0, internalFormat = 0;
+    glBindTexture(GL_TEXTURE_2D, job.texture);
+    glGetTexLevelParameteriv(GL_TEXTURE_2D, level, GL_TEXTURE_WIDTH, &width);
+    glGetTexLevelParameteriv(GL_TEXTURE_2D, level, GL_TEXTURE_COMPRESSED, &compressed);
+    glGetTexLevelParameteriv(GL_TEXTURE_2D, level, GL_TEXTURE_INTERNAL_FORMAT, &internalFormat);
+
+    if (level >= jobLevelCount(job) || (compressed != 0) != job.useCompressed) return false;
+    if (job.useCompressed) {
+        return width == std::max(1, job.compressed[0].width >> level)
+            && (GLenum)internalFormat == compressedInternalFormat(job.compressed[0].format);
+    }
+    return width == std::max(1, job.images[0].width >> level);
+}
+
+// 2D 纹理渐进上传，返回 true 表示全部级别已上传（或加载失败）：
+// 第一步上传不超过 kStreamingBaseSize 的所有低级别 mip，纹理立即以低分辨率可用；
+// 之后每步上传高一级并下调 GL_TEXTURE_BASE_LEVEL，直到 stopLevel（默认第 0 级）。
+// 恢复任务（resumeLevel > 0）跳过第一步，直接从已驻留级别的上一级开始
+bool uploadTextureStep(TextureJob& job) {
+    bool uploadNext = true;
+    if (!job.started) {
+        job.started = true;
+        if (!validateJob(job)) {
+            releaseJob(job);
+            return true;
+        }
+
+        if (job.resumeLevel > 0 && residentLevelsMatch(job)) {
+            job.nextLevel = job.resumeLevel - 1;
+        } else {
+            int levels = jobLevelCount(job);
+            int width = job.useCompressed ? job.compressed[0].width : job.images[0].width;
+            int height = job.useCompressed ? job.compressed[0].height : job.images[0].height;
+            int first = 0;
+            while (first < levels - 1 && std::max(width >> first, height >> first) > kStreamingBaseSize) {
+                first++;
+            }
+
+            beginUpload(job);
+            for (int level = levels - 1; level >= first; level--) {
+                uploadLevel(job, 0, GL_TEXTURE_2D, level);
+            }
+            endUpload();
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, first);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, levels - 1);
+            job.nextLevel = first - 1;
+            uploadNext = false;
+        }
+    }
+
+    if (uploadNext && job.nextLevel >= job.stopLevel) {
+        beginUpload(job);
+        uploadLevel(job, 0, GL_TEXTURE_2D, job.nextLevel);
+        endUpload();
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, job.nextLevel);
+        job.nextLevel--;
+    }
+
+    if (job.nextLevel >= job.stopLevel) return false;
+    if (job.resumeLevel > 0) {
+        std::cout << "Texture restored to mip " << job.nextLevel + 1 << ": " << job.paths[0] << std::endl;
+    } else {
+        std::cout << "Texture loaded successfully: " << job.paths[0] << std::endl;
+    }
+    releaseJob(job);
+    return true;
+}
+
+// 需在主线程调用（查询 GL 扩展）
+bool compressionAvailable() {
+    return loaderState().compressionEnabled && isS3TCSupported();
+}
+
+// 选择下一个上传的任务：尚未开始的纹理优先（先让所有纹理以低分辨率可用），其次按屏幕尺寸
+std::deque<std::shared_ptr<TextureJob>>::iterator pickNextJob(std::deque<std::shared_ptr<TextureJob>>& ready) {
+    auto best = ready.begin();
+    for (auto it = ready.begin(); it != ready.end(); ++it) {
+        const TextureJob& job = **it;
+        const TextureJob& current = **best;
+        if (job.canceled) return it;
+        if (job.started != current.started ? !job.started : job.priority > current.priority) {
+            best = it;
+        }
+    }
+    return best;
+}
+
+} // namespace
+
+void setTextureCompression(bool enabled) {
+    loaderState().compressionEnabled = enabled;
+}
+
+unsigned int loadTextureAsync(const char* path) {
+    unsigned int textureID;
+    glGenTextures(1, &textureID);
+    createPlaceholder(textureID, GL_TEXTURE_2D);
+
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+    auto job = std::make_shared<TextureJob>();
+    job->texture = textureID;
+    job->target = GL_TEXTURE_2D;
+    job->paths.push_back(path);
+    job->compress = compressionAvailable();
+    job->qualityShift = (int)getTextureQuality();
+    submitJob(job);
+    return textureID;
+}
+
+unsigned int loadCubemapAsync(const std::vector<std::string>& faces) {
+    unsigned int textureID;
+    glGenTextures(1, &textureID);
+    createPlaceholder(textureID, GL_TEXTURE_CUBE_MAP);
+
+    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
+
+    auto job = std::make_shared<TextureJob>();
+    job->texture = textureID;
+    job->target = GL_TEXTURE_CUBE_MAP;
+    job->paths = faces;
+    job->compress = compressionAvailable();
+    job->mipmaps = false; // 天空盒只采样第 0 级
+    submitJob(job);
+    return textureID;
+}
+
+unsigned int loadTextureArrayAsync(const std::vector<std::string>& layers, int maxLayerSize) {
+    unsigned int textureID;
+    glGenTextures(1, &textureID);
+    createPlaceholder(textureID, GL_TEXTURE_2D_ARRAY, layers.size());
+
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAX_LEVEL, 0);
+
+    auto job = std::make_shared<TextureJob>();
+    job->texture = textureID;
+    job->target = GL_TEXTURE_2D_ARRAY;
+    job->paths = layers;
+    job->qualityShift = (int)getTextureQuality();
+    job->maxLayerSize = (maxLayerSize > 0) ? std::max(1, maxLayerSize >> job->qualityShift) : 0;
+    submitJob(job);
+    return textureID;
+}
+
+void restoreTextureAsync(unsigned int texture, const std::string& path, int topLevel) {
+    GLint baseLevel = 0;
+    glBindTexture(GL_TEXTURE_2D, texture);
+    glGetTexParameteriv(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, &baseLevel);
+    if (baseLevel <= topLevel || isTextureLoading(texture)) return;
+
+    auto job = std::make_shared<TextureJob>();
+    job->texture = texture;
+    job->target = GL_TEXTURE_2D;
+    job->paths.push_back(path);
+    job->compress = compressionAvailable();
+    job->qualityShift = (int)getTextureQuality();
+    job->resumeLevel = baseLevel;
+    job->stopLevel = std::max(topLevel, 0);
+    submitJob(job);
+}
+
+size_t processTextureUploads(double budgetMs) {
+    LoaderState& state = loaderState();
+    auto start = std::chrono::steady_clock::now();
+    size_t uploaded = 0;
+    {
+        std::lock_guard<std::mutex> lock(state.mutex);
+        state.frame++;
+    }
+
+    while (true) {
+        std::shared_ptr<TextureJob> job;
+        {
+            std::lock_guard<std::mutex> lock(state.mutex);
+            if (state.ready.empty()) break;
+            auto it = pickNextJob(state.ready);
+            job = *it;
+            state.ready.erase(it);
+        }
+
+        if (job->canceled) {
+            releaseJob(*job);
+            continue;
+        }
+
+        bool finished = true;
+        if (job->target == GL_TEXTURE_2D_ARRAY) {
+            uploadArrayJob(*job);
+        } else if (job->target == GL_TEXTURE_CUBE_MAP) {
+            uploadCubemapJob(*job);
+        } else {
+            finished = uploadTextureStep(*job);
+        }
+        uploaded++;
+
+        {
+            std::lock_guard<std::mutex> lock(state.mutex);
+            if (!finished) {
+                state.ready.push_back(job);
+            } else {
+                auto it = state.inFlight.find(job->texture);
+                if (it != state.inFlight.end() && it->second == job) state.inFlight.erase(it);
+            }
+        }
+
+        double elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        if (elapsed >= budgetMs) break;
+    }
+    return uploaded;
+}
+
+void setTextureScreenSize(unsigned int texture, float pixels) {
+    LoaderState& state = loaderState();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    auto it = state.inFlight.find(texture);
+    if (it != state.inFlight.end()) {
+        // 同一帧内多次使用取最大值，新的一帧重新计算
+        TextureJob& job = *it->second;
+        job.priority = (job.priorityFrame == state.frame) ? std::max(job.priority, pixels) : pixels;
+        job.priorityFrame = state.frame;
+    }
+}
+
+size_t pendingTextureCount() {
+    LoaderState& state = loaderState();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    return state.inFlight.size();
+}
+
+bool isTextureLoading(unsigned int texture) {
+    LoaderState& state = loaderState();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    return state.inFlight.count(texture) > 0;
+}
+
+void cancelTextureLoad(unsigned int texture) {
+    LoaderState& state = loaderState();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    auto it = state.inFlight.find(texture);
+    if (it != state.inFlight.end()) {
+        // 解码任务仍持有 job，完成后在上传阶段丢弃
+        it->second->canceled = true;
+        state.inFlight.erase(it);
+    }
+}
+
+void finishTextureUploads() {
+    while (pendingTextureCount() > 0) {
+        if (processTextureUploads(1e9) == 0) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+}
+
+void shutdownTextureLoader() {
+    LoaderState& state = loaderState();
+    shutdownFileReader(); // 先等待在途读取交给线程池，再等待解码完成
+    getThreadPool().waitIdle();
+
+    std::lock_guard<std::mutex> lock(state.mutex);
+    for (const std::shared_ptr<TextureJob>& job : state.ready) {
+        releaseJob(*job);
+    }
+    state.ready.clear();
+    state.inFlight.clear();
+    if (state.pixelBuffer != 0) {
+        glDeleteBuffers(1, &state.pixelBuffer);
+        state.pixelBuffer = 0;
+    }
+}
@@ -0,0 +1,49 @@
+#ifndef ASYNC_TEXTURE_H
+#define ASYNC_TEXTURE_H
+
+#include <glad/glad.h>
+#include <vector>
+#include <string>
+#include <cstddef>
+
+// 异步纹理加载：工作线程解码图像，主线程通过 PBO 分帧上传
+// 返回的纹理 ID 立即可用（1x1 占位纹理），上传完成后原地替换为真实图像
+unsigned int loadTextureAsync(const char* path);
+unsigned int loadCubemapAsync(const std::vector<std::string>& faces); // 六个面并行解码
+
+// GL_TEXTURE_2D_ARRAY：每个路径一层，统一重采样到同一正方形尺寸（各层最大边长，不超过 maxLayerSize）
+// 着色器用层索引选择材质，整组材质只需绑定一次。数组层不做块压缩
+unsigned int loadTextureArrayAsync(const std::vector<std::string>& layers, int maxLayerSize = 1024);
+
+// 纹理压缩（默认开启）：驱动支持 S3TC 时加载烘焙好的 BC1/BC3 纹理（<图像路径>.dds），
+// 缓存缺失或过期时在工作线程中重新编码；不支持时自动回退为未压缩上传。只影响之后提交的纹理
+void setTextureCompression(bool enabled);
+
+// 主线程每帧调用：在 budgetMs 时间预算内执行上传步骤（每帧至少一步），返回本帧执行的步数。
+// 2D 纹理渐进上传：第一步上传 64x64 及以下的 mip 级别，之后每步补一级更高分辨率并下调
+// GL_TEXTURE_BASE_LEVEL；未开始的纹理优先，其次按屏幕尺寸排序
+size_t processTextureUploads(double budgetMs);
+
+// 报告纹理本帧在屏幕上的尺寸（像素，可多次调用取最大值），决定渐进上传的先后顺序
+void setTextureScreenSize(unsigned int texture, float pixels);
+
+// 纹理被驻留管理器降级（丢弃高分辨率 mip）后按需恢复：重新解码（或读取烘焙缓存），
+// 从当前 GL_TEXTURE_BASE_LEVEL 起逐级上传直到 topLevel。纹理仍在加载时忽略
+void restoreTextureAsync(unsigned int texture, const std::string& path, int topLevel = 0);
+
+// 尚未完成（解码中、等待上传或仍在补全高分辨率 mip）的纹理数
+size_t pendingTextureCount();
+
+// 纹理是否仍在解码或等待上传
+bool isTextureLoading(unsigned int texture);
+
+// 删除纹理前调用：丢弃尚未上传的结果（纹理名可能被之后的 glGenTextures 复用）
+void cancelTextureLoad(unsigned int texture);
+
+// 阻塞直到所有已提交的纹理上传完成
+void finishTextureUploads();
+
+// 退出前调用（需要 GL 上下文）：等待解码任务结束，释放未上传的图像与 PBO
+void shutdownTextureLoader();
+
+#endif // ASYNC_TEXTURE_H
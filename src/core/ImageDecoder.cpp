@@ -0,0 +1,151 @@
+#include "ImageDecoder.h"
+#include "MipGenerator.h"
+#include "VirtualFileSystem.h"
+#include "../../include/stb/stb_image.h"
+#include <vector>
+#include <climits>
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+
+#ifdef FOREST_LIBJPEG_TURBO
+#include <cstdio>
+#include <csetjmp>
+#include <jpeglib.h>
+#ifndef JCS_EXTENSIONS
+#error "FOREST_USE_LIBJPEG_TURBO requires libjpeg-turbo (JCS_EXT_RGBA)"
+#endif
+#endif
+
+namespace {
+
+// 所有路径的像素都由 malloc 分配（stb_image 使用默认的 STBI_MALLOC / STBI_FREE）
+unsigned char* copyToMalloc(const std::vector<unsigned char>& pixels) {
+    unsigned char* result = (unsigned char*)std::malloc(pixels.size());
+    if (result) std::memcpy(result, pixels.data(), pixels.size());
+    return result;
+}
+
+// stb_image 路径的缩小：逐级 2x2 降采样
+unsigned char* downscale(unsigned char* pixels, int* width, int* height, int channels, int scaleShift) {
+    std::vector<unsigned char> current, next;
+    const unsigned char* src = pixels;
+    for (int i = 0; i < scaleShift && (*width > 1 || *height > 1); i++) {
+        downsampleImage(src, *width, *height, channels, true, next);
+        current.swap(next);
+        src = current.data();
+        *width = std::max(1, *width / 2);
+        *height = std::max(1, *height / 2);
+    }
+    if (src == pixels) return pixels;
+    stbi_image_free(pixels);
+    return copyToMalloc(current);
+}
+
+#ifdef FOREST_LIBJPEG_TURBO
+struct JpegError {
+    jpeg_error_mgr manager;
+    std::jmp_buf jump;
+};
+
+void onJpegError(j_common_ptr info) {
+    JpegError* error = (JpegError*)info->err;
+    std::longjmp(error->jump, 1);
+}
+
+bool isJpeg(const uint8_t* data, size_t size) {
+    return size > 3 && data[0] == 0xFF && data[1] == 0xD8 && data[2] == 0xFF;
+}
+
+// 解码为 desiredChannels 通道（0 表示保持灰度 / RGB），scaleShift 映射为 libjpeg 的 1/2^n 缩放
+unsigned char* decodeJpeg(const uint8_t* data, size_t size, int* width, int* height, int* channels,
+    int desiredChannels, int scaleShift) {
+    jpeg_decompress_struct info;
+    JpegError error;
+    unsigned char* volatile pixels = nullptr; // longjmp 之后仍需读取
+
+    info.err = jpeg_std_error(&error.manager);
+    error.manager.error_exit = onJpegError;
+    if (setjmp(error.jump)) {
+        jpeg_destroy_decompress(&info);
+        std::free(pixels);
+        return nullptr;
+    }
+
+    jpeg_create_decompress(&info);
+    jpeg_mem_src(&info, data, (unsigned long)size);
+    jpeg_read_header(&info, TRUE);
+
+    int fileChannels = (info.num_components == 1) ? 1 : 3;
+    int outChannels = desiredChannels ? desiredChannels : fileChannels;
+    switch (outChannels) {
+    case 1: info.out_color_space = JCS_GRAYSCALE; break;
+    case 4: info.out_color_space = JCS_EXT_RGBA; break;
+    default: info.out_color_space = JCS_RGB; outChannels = 3; break;
+    }
+    info.scale_num = 1;
+    info.scale_denom = 1u << std::min(std::max(scaleShift, 0), 3);
+    info.dct_method = JDCT_ISLOW;
+
+    jpeg_start_decompress(&info);
+    size_t stride = (size_t)info.output_width * outChannels;
+    pixels = (unsigned char*)std::malloc(stride * info.output_height);
+    if (!pixels) {
+        jpeg_destroy_decompress(&info);
+        return nullptr;
+    }
+    while (info.output_scanline < info.output_height) {
+        JSAMPROW row = pixels + stride * info.output_scanline;
+        jpeg_read_scanlines(&info, &row, 1);
+    }
+    jpeg_finish_decompress(&info);
+
+    *width = (int)info.output_width;
+    *height = (int)info.output_height;
+    *channels = fileChannels;
+    jpeg_destroy_decompress(&info);
+    return pixels;
+}
+#endif
+
+} // namespace
+
+unsigned char* loadImage(const char* path, int* width, int* height, int* channels,
+    int desiredChannels, int scaleShift) {
+    // 经虚拟文件系统读取（资源包内的未压缩条目直接从映射内存解码）
+    VirtualFile file;
+    if (!file.open(path)) return nullptr;
+    return loadImageFromMemory(file.data(), file.size(), width, height, channels, desiredChannels, scaleShift);
+}
+
+unsigned char* loadImageFromMemory(const uint8_t* data, size_t size, int* width, int* height, int* channels,
+    int desiredChannels, int scaleShift) {
+    if (!data || size > (size_t)INT_MAX) return nullptr;
+
+#ifdef FOREST_LIBJPEG_TURBO
+    if (desiredChannels != 2 && isJpeg(data, size)) {
+        int fileChannels = 0;
+        unsigned char* pixels = decodeJpeg(data, size, width, height, &fileChannels, desiredChannels, scaleShift);
+        if (pixels) {
+            *channels = fileChannels;
+            return pixels;
+        }
+    }
+#endif
+
+    unsigned char* pixels = stbi_load_from_memory(data, (int)size, width, height, channels, desiredChannels);
+    if (!pixels || scaleShift <= 0) return pixels;
+    return downscale(pixels, width, height, desiredChannels ? desiredChannels : *channels, scaleShift);
+}
+
+void freeImage(unsigned char* pixels) {
+    std::free(pixels);
+}
+
+const char* getJpegDecoderName() {
+#ifdef FOREST_LIBJPEG_TURBO
+    return "libjpeg-turbo";
+#else
+    return "stb_image";
+#endif
+}
@@ -0,0 +1,24 @@
+#ifndef IMAGE_DECODER_H
+#define IMAGE_DECODER_H
+
+#include <cstddef>
+#include <cstdint>
+
+// 图像解码：构建时启用 FOREST_USE_LIBJPEG_TURBO 后 JPEG 走 libjpeg-turbo（SIMD IDCT / 颜色转换），
+// 其余格式及未启用时使用 stb_image。文件经虚拟文件系统读取（资源包或散文件）。输出行紧密排列、自上而下，可直接按 GL_UNPACK_ALIGNMENT = 1 上传。
+// scaleShift 为降采样级数（1 = 1/2，2 = 1/4）：libjpeg-turbo 在 DCT 域直接输出缩小的图像，
+// stb_image 路径解码后做 gamma 校正的 2x2 降采样。desiredChannels 为 0 时保持文件的通道数
+unsigned char* loadImage(const char* path, int* width, int* height, int* channels,
+    int desiredChannels = 0, int scaleShift = 0);
+
+// 从已读入内存的文件数据解码（异步读取完成后在回调中调用），参数与 loadImage 相同
+unsigned char* loadImageFromMemory(const uint8_t* data, size_t size, int* width, int* height, int* channels,
+    int desiredChannels = 0, int scaleShift = 0);
+
+// 释放 loadImage 返回的像素
+void freeImage(unsigned char* pixels);
+
+// 当前构建的 JPEG 解码后端（"libjpeg-turbo" / "stb_image"）
+const char* getJpegDecoderName();
+
+#endif // IMAGE_DECODER_H
@@ -0,0 +1,341 @@
+#include "MeshCache.h"
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <cstring>
+#include <system_error>
+#include <thread>
+#include <functional>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+const char kMagic[4] = { 'S', 'F', 'M', 'C' };
+const uint32_t kVersion = 1;
+const size_t kBlobAlignment = 16;
+
+struct MeshCacheHeader {
+    char magic[4];
+    uint32_t version;
+    uint32_t optionsKey;
+    uint32_t meshCount;
+    uint64_t sourceSize;
+    int64_t sourceMtime;
+    uint64_t sourceHash;
+    uint32_t materialCount;
+    uint32_t vertexSize;  // sizeof(Vertex)，布局变化时缓存失效
+    float boundsMin[3];
+    float boundsMax[3];
+    float scaleFactor;
+    uint32_t meshletSize; // sizeof(Meshlet)
+};
+
+struct MeshCacheEntry {
+    uint32_t materialIndex;
+    uint32_t atlasTiling;
+    float atlasTile[4];
+    uint64_t vertexOffset;
+    uint64_t vertexCount;
+    uint64_t indexOffset;
+    uint64_t indexCount;
+    uint64_t meshletOffset;
+    uint64_t meshletCount;
+};
+
+static_assert(sizeof(MeshCacheHeader) == 80, "MeshCacheHeader layout changed");
+static_assert(sizeof(MeshCacheEntry) == 72, "MeshCacheEntry layout changed");
+
+uint64_t fnv1a64(const uint8_t* data, size_t size) {
+    uint64_t hash = 14695981039346656037ull;
+    for (size_t i = 0; i < size; i++) {
+        hash ^= data[i];
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+size_t alignUp(size_t value) {
+    return (value + kBlobAlignment - 1) & ~(kBlobAlignment - 1);
+}
+
+// 带越界检查的顺序读取
+struct Reader {
+    const uint8_t* data;
+    size_t size;
+    size_t pos;
+
+    bool read(void* out, size_t bytes) {
+        if (bytes > size - pos) return false;
+        std::memcpy(out, data + pos, bytes);
+        pos += bytes;
+        return true;
+    }
+
+    bool readString(std::string& out) {
+        uint32_t length = 0;
+        if (!read(&length, sizeof(length)) || length > size - pos) return false;
+        out.assign(reinterpret_cast<const char*>(data + pos), length);
+        pos += length;
+        return true;
+    }
+};
+
+void appendBytes(std::vector<uint8_t>& buffer, const void* data, size_t bytes) {
+    const uint8_t* p = static_cast<const uint8_t*>(data);
+    buffer.insert(buffer.end(), p, p + bytes);
+}
+
+void appendString(std::vector<uint8_t>& buffer, const std::string& str) {
+    uint32_t length = (uint32_t)str.size();
+    appendBytes(buffer, &length, sizeof(length));
+    appendBytes(buffer, str.data(), str.size());
+}
+
+// 数据块必须完整落在文件内且按元素大小对齐
+bool checkBlob(uint64_t offset, uint64_t count, size_t elementSize, size_t fileSize) {
+    if (offset % kBlobAlignment != 0 || offset > fileSize) return false;
+    return count <= (fileSize - offset) / elementSize;
+}
+
+// 索引必须指向本网格的顶点，簇的索引区间必须落在索引数组内（否则绘制时越界读取）
+bool checkMeshRanges(const MeshCacheMeshView& mesh) {
+    for (size_t i = 0; i < mesh.indexCount; i++) {
+        if (mesh.indices[i] >= mesh.vertexCount) return false;
+    }
+    for (size_t i = 0; i < mesh.meshletCount; i++) {
+        const Meshlet& meshlet = mesh.meshlets[i];
+        if ((uint64_t)meshlet.indexOffset + meshlet.indexCount > mesh.indexCount) return false;
+    }
+    return true;
+}
+
+} // namespace
+
+std::string getMeshCachePath(const std::string& sourcePath) {
+    return sourcePath + ".meshcache";
+}
+
+bool queryMeshCacheSource(const std::string& path, MeshCacheSource& source, bool computeHash) {
+    PackedFileInfo packed;
+    if (findPackedFile(path, packed)) {
+        source.size = packed.size;
+        source.mtime = packed.mtime;
+        source.hash = computeHash ? packed.hash : 0;
+        return true;
+    }
+
+    std::error_code ec;
+    uintmax_t size = fs::file_size(path, ec);
+    if (ec) return false;
+    fs::file_time_type mtime = fs::last_write_time(path, ec);
+    if (ec) return false;
+
+    source.size = (uint64_t)size;
+    source.mtime = (int64_t)mtime.time_since_epoch().count();
+    source.hash = 0;
+
+    if (computeHash) {
+        MappedFile file;
+        if (!file.open(path)) return false;
+        source.hash = fnv1a64(file.data(), file.size());
+    }
+    return true;
+}
+
+bool readMeshCache(const std::string& sourcePath, uint32_t optionsKey, VirtualFile& file, MeshCacheView& view) {
+    std::string cachePath = getMeshCachePath(sourcePath);
+    if (!file.open(cachePath)) return false;
+
+    Reader reader{ file.data(), file.size(), 0 };
+    MeshCacheHeader header;
+    if (!reader.read(&header, sizeof(header)) || std::memcmp(header.magic, kMagic, 4) != 0) {
+        std::cerr << "[MeshCache] Invalid cache file: " << cachePath << std::endl;
+        file.close();
+        return false;
+    }
+    if (header.version != kVersion || header.vertexSize != sizeof(Vertex)
+        || header.meshletSize != sizeof(Meshlet) || header.optionsKey != optionsKey) {
+        std::cout << "[MeshCache] Cache is stale (version / layout / options changed): " << cachePath << std::endl;
+        file.close();
+        return false;
+    }
+
+    // 源文件校验：大小与修改时间相同直接命中，否则退回内容哈希（例如重新检出后仅 mtime 变化）
+    MeshCacheSource source;
+    if (queryMeshCacheSource(sourcePath, source, false)) {
+        if (source.size != header.sourceSize) {
+            std::cout << "[MeshCache] Source changed, cache invalidated: " << sourcePath << std::endl;
+            file.close();
+            return false;
+        }
+        if (source.mtime != header.sourceMtime) {
+            if (!queryMeshCacheSource(sourcePath, source, true) || source.hash != header.sourceHash) {
+                std::cout << "[MeshCache] Source changed, cache invalidated: " << sourcePath << std::endl;
+                file.close();
+                return false;
+            }
+        }
+    } else {
+        std::cout << "[MeshCache] Source not found, using cache as-is: " << sourcePath << std::endl;
+    }
+
+    std::vector<MeshCacheEntry> entries(header.meshCount);
+    if (header.meshCount > file.size() / sizeof(MeshCacheEntry)
+        || !reader.read(entries.data(), entries.size() * sizeof(MeshCacheEntry))) {
+        file.close();
+        return false;
+    }
+
+    view.materials.clear();
+    for (uint32_t i = 0; i < header.materialCount; i++) {
+        ModelMaterial material;
+        uint32_t opaque = 1;
+        if (!reader.readString(material.name) || !reader.readString(material.diffusePath)
+            || !reader.read(&opaque, sizeof(opaque))) {
+            std::cerr << "[MeshCache] Truncated material table: " << cachePath << std::endl;
+            file.close();
+            return false;
+        }
+        material.opaque = opaque != 0;
+        view.materials.push_back(material);
+    }
+
+    view.meshes.clear();
+    for (const MeshCacheEntry& entry : entries) {
+        if (!checkBlob(entry.vertexOffset, entry.vertexCount, sizeof(Vertex), file.size())
+            || !checkBlob(entry.indexOffset, entry.indexCount, sizeof(unsigned int), file.size())
+            || !checkBlob(entry.meshletOffset, entry.meshletCount, sizeof(Meshlet), file.size())
+            || entry.materialIndex >= view.materials.size()) {
+            std::cerr << "[MeshCache] Corrupt mesh entry: " << cachePath << std::endl;
+            file.close();
+            return false;
+        }
+
+        MeshCacheMeshView mesh;
+        mesh.vertices = reinterpret_cast<const Vertex*>(file.data() + entry.vertexOffset);
+        mesh.vertexCount = (size_t)entry.vertexCount;
+        mesh.indices = reinterpret_cast<const unsigned int*>(file.data() + entry.indexOffset);
+        mesh.indexCount = (size_t)entry.indexCount;
+        mesh.meshlets = reinterpret_cast<const Meshlet*>(file.data() + entry.meshletOffset);
+        mesh.meshletCount = (size_t)entry.meshletCount;
+        mesh.materialIndex = entry.materialIndex;
+        mesh.atlasTiling = entry.atlasTiling != 0;
+        mesh.atlasTile = glm::vec4(entry.atlasTile[0], entry.atlasTile[1], entry.atlasTile[2], entry.atlasTile[3]);
+        if (!checkMeshRanges(mesh)) {
+            std::cerr << "[MeshCache] Index or meshlet range out of bounds: " << cachePath << std::endl;
+            file.close();
+            return false;
+        }
+        view.meshes.push_back(mesh);
+    }
+
+    view.boundsMin = glm::vec3(header.boundsMin[0], header.boundsMin[1], header.boundsMin[2]);
+    view.boundsMax = glm::vec3(header.boundsMax[0], header.boundsMax[1], header.boundsMax[2]);
+    view.scaleFactor = header.scaleFactor;
+    return true;
+}
+
+bool writeMeshCache(const std::string& sourcePath, uint32_t optionsKey,
+    const glm::vec3& boundsMin, const glm::vec3& boundsMax, float scaleFactor,
+    const std::vector<MeshData>& meshes, const std::vector<ModelMaterial>& materials) {
+    MeshCacheSource source;
+    if (!queryMeshCacheSource(sourcePath, source, true)) {
+        std::cerr << "[MeshCache] Cannot stat source: " << sourcePath << std::endl;
+        return false;
+    }
+
+    MeshCacheHeader header = {};
+    std::memcpy(header.magic, kMagic, 4);
+    header.version = kVersion;
+    header.optionsKey = optionsKey;
+    header.meshCount = (uint32_t)meshes.size();
+    header.sourceSize = source.size;
+    header.sourceMtime = source.mtime;
+    header.sourceHash = source.hash;
+    header.materialCount = (uint32_t)materials.size();
+    header.vertexSize = sizeof(Vertex);
+    for (int k = 0; k < 3; k++) {
+        header.boundsMin[k] = boundsMin[k];
+        header.boundsMax[k] = boundsMax[k];
+    }
+    header.scaleFactor = scaleFactor;
+    header.meshletSize = sizeof(Meshlet);
+
+    // 材质表
+    std::vector<uint8_t> materialTable;
+    for (const ModelMaterial& material : materials) {
+        uint32_t opaque = material.opaque ? 1 : 0;
+        appendString(materialTable, material.name);
+        appendString(materialTable, material.diffusePath);
+        appendBytes(materialTable, &opaque, sizeof(opaque));
+    }
+
+    // 计算各数据块偏移
+    std::vector<MeshCacheEntry> entries(meshes.size());
+    size_t offset = alignUp(sizeof(header) + entries.size() * sizeof(MeshCacheEntry) + materialTable.size());
+    for (size_t i = 0; i < meshes.size(); i++) {
+        const MeshData& data = meshes[i];
+        MeshCacheEntry& entry = entries[i];
+        entry.materialIndex = data.materialIndex;
+        entry.atlasTiling = data.atlasTiling ? 1 : 0;
+        for (int k = 0; k < 4; k++) entry.atlasTile[k] = data.atlasTile[k];
+
+        entry.vertexOffset = offset;
+        entry.vertexCount = data.vertices.size();
+        offset = alignUp(offset + data.vertices.size() * sizeof(Vertex));
+        entry.indexOffset = offset;
+        entry.indexCount = data.indices.size();
+        offset = alignUp(offset + data.indices.size() * sizeof(unsigned int));
+        entry.meshletOffset = offset;
+        entry.meshletCount = data.meshlets.size();
+        offset = alignUp(offset + data.meshlets.size() * sizeof(Meshlet));
+    }
+
+    std::string cachePath = getMeshCachePath(sourcePath);
+    // 同一模型可能在多个工作线程上同时加载（导入选项只在 GPU 端不同的注册表句柄），临时文件按线程区分
+    std::string tempPath = cachePath + ".tmp" + std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id()));
+    {
+        std::ofstream out(tempPath, std::ios::binary | std::ios::trunc);
+        if (!out) {
+            std::cerr << "[MeshCache] Cannot write cache: " << tempPath << std::endl;
+            return false;
+        }
+
+        static const char padding[kBlobAlignment] = {};
+        size_t written = 0;
+        auto write = [&](const void* data, size_t bytes) {
+            out.write(static_cast<const char*>(data), (std::streamsize)bytes);
+            written += bytes;
+        };
+        auto pad = [&]() {
+            write(padding, alignUp(written) - written);
+        };
+
+        write(&header, sizeof(header));
+        write(entries.data(), entries.size() * sizeof(MeshCacheEntry));
+        write(materialTable.data(), materialTable.size());
+        pad();
+        for (const MeshData& data : meshes) {
+            write(data.vertices.data(), data.vertices.size() * sizeof(Vertex));
+            pad();
+            write(data.indices.data(), data.indices.size() * sizeof(unsigned int));
+            pad();
+            write(data.meshlets.data(), data.meshlets.size() * sizeof(Meshlet));
+            pad();
+        }
+        if (!out) {
+            std::cerr << "[MeshCache] Failed while writing cache: " << tempPath << std::endl;
+            return false;
+        }
+    }
+
+    std::error_code ec;
+    fs::rename(tempPath, cachePath, ec);
+    if (ec) {
+        std::cerr << "[MeshCache] Cannot replace cache " << cachePath << ": " << ec.message() << std::endl;
+        fs::remove(tempPath, ec);
+        return false;
+    }
+    return true;
+}
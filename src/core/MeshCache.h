@@ -0,0 +1,57 @@
+#ifndef MESH_CACHE_H
+#define MESH_CACHE_H
+
+#include "../geometry/Mesh.h"
+#include "VirtualFileSystem.h"
+#include <glm/glm.hpp>
+#include <string>
+#include <vector>
+#include <cstdint>
+
+// 模型二进制缓存（<模型路径>.meshcache）
+// 布局：文件头 | 网格表 | 材质表 | 16 字节对齐的顶点 / 索引 / meshlet 数据块
+// 保存的是导入、优化之后的最终结果，读取时通过内存映射直接上传，不做任何解析
+
+// 源文件标识：大小与修改时间一致即视为未变；否则比较内容哈希
+struct MeshCacheSource {
+    uint64_t size = 0;
+    int64_t mtime = 0;
+    uint64_t hash = 0;
+};
+
+// 指向映射内存的网格视图（VirtualFile 关闭后失效）
+struct MeshCacheMeshView {
+    const Vertex* vertices = nullptr;
+    size_t vertexCount = 0;
+    const unsigned int* indices = nullptr;
+    size_t indexCount = 0;
+    const Meshlet* meshlets = nullptr;
+    size_t meshletCount = 0;
+    unsigned int materialIndex = 0;
+    bool atlasTiling = false;
+    glm::vec4 atlasTile = glm::vec4(0, 0, 1, 1);
+};
+
+struct MeshCacheView {
+    glm::vec3 boundsMin = glm::vec3(0.0f);
+    glm::vec3 boundsMax = glm::vec3(0.0f);
+    float scaleFactor = 1.0f;
+    std::vector<MeshCacheMeshView> meshes;
+    std::vector<ModelMaterial> materials;
+};
+
+std::string getMeshCachePath(const std::string& sourcePath);
+
+// 读取源文件大小 / 修改时间，computeHash 为 true 时同时计算内容哈希（FNV-1a 64）
+// 源文件在已挂载的资源包中时使用打包时记录的信息
+bool queryMeshCacheSource(const std::string& path, MeshCacheSource& source, bool computeHash);
+
+// 映射并校验缓存（版本、顶点布局、导入选项、源文件），成功时 view 指向 file 的映射内存
+bool readMeshCache(const std::string& sourcePath, uint32_t optionsKey, VirtualFile& file, MeshCacheView& view);
+
+// 写入缓存（先写临时文件再替换，避免留下不完整的缓存）
+bool writeMeshCache(const std::string& sourcePath, uint32_t optionsKey,
+    const glm::vec3& boundsMin, const glm::vec3& boundsMax, float scaleFactor,
+    const std::vector<MeshData>& meshes, const std::vector<ModelMaterial>& materials);
+
+#endif // MESH_CACHE_H
@@ -0,0 +1,194 @@
+#include "MipGenerator.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+#define STB_IMAGE_RESIZE_IMPLEMENTATION
+#include "../../include/stb/stb_image_resize.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define MIP_GENERATOR_SSE2 1
+#endif
+
+namespace {
+
+const int kEncodeSteps = 4096; // 线性 -> sRGB 查找表精度（12 位）
+
+struct GammaTables {
+    float toLinear[256];             // sRGB 字节 -> 线性 [0, 1]
+    float identity[256];             // 字节 -> [0, 1]（alpha / 非颜色数据）
+    unsigned char toSrgb[kEncodeSteps + 1];
+
+    GammaTables() {
+        for (int i = 0; i < 256; i++) {
+            float c = i / 255.0f;
+            toLinear[i] = (c <= 0.04045f) ? c / 12.92f : std::pow((c + 0.055f) / 1.055f, 2.4f);
+            identity[i] = c;
+        }
+        for (int i = 0; i <= kEncodeSteps; i++) {
+            float l = (float)i / kEncodeSteps;
+            float c = (l <= 0.0031308f) ? l * 12.92f : 1.055f * std::pow(l, 1.0f / 2.4f) - 0.055f;
+            toSrgb[i] = (unsigned char)std::min(255.0f, c * 255.0f + 0.5f);
+        }
+    }
+};
+
+const GammaTables& gammaTables() {
+    static GammaTables tables;
+    return tables;
+}
+
+// 每个通道的解码表；srgb 时前三个颜色通道使用 sRGB 曲线
+void channelTables(const GammaTables& tables, int channels, bool srgb, const float* decode[4], bool encodeSrgb[4]) {
+    for (int c = 0; c < 4; c++) {
+        bool color = srgb && channels >= 3 && c < 3;
+        decode[c] = color ? tables.toLinear : tables.identity;
+        encodeSrgb[c] = color;
+    }
+}
+
+// 逐元素相加：dst[i] = a[i] + b[i]
+void addRows(const float* a, const float* b, float* dst, size_t count) {
+    size_t i = 0;
+#ifdef MIP_GENERATOR_SSE2
+    for (; i + 4 <= count; i += 4) {
+        _mm_storeu_ps(dst + i, _mm_add_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)));
+    }
+#endif
+    for (; i < count; i++) {
+        dst[i] = a[i] + b[i];
+    }
+}
+
+// 平均值（四个样本之和）转换为查找表下标与字节值，截断前加 0.5 以四舍五入
+void quantize(const float* sums, int* encoded, int* bytes, size_t count) {
+    size_t i = 0;
+#ifdef MIP_GENERATOR_SSE2
+    const __m128 quarter = _mm_set1_ps(0.25f);
+    const __m128 half = _mm_set1_ps(0.5f);
+    const __m128 steps = _mm_set1_ps((float)kEncodeSteps);
+    const __m128 byteMax = _mm_set1_ps(255.0f);
+    for (; i + 4 <= count; i += 4) {
+        __m128 average = _mm_mul_ps(_mm_loadu_ps(sums + i), quarter);
+        _mm_storeu_si128((__m128i*)(encoded + i), _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(average, steps), half)));
+        _mm_storeu_si128((__m128i*)(bytes + i), _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(average, byteMax), half)));
+    }
+#endif
+    for (; i < count; i++) {
+        float average = sums[i] * 0.25f;
+        encoded[i] = (int)(average * kEncodeSteps + 0.5f);
+        bytes[i] = (int)(average * 255.0f + 0.5f);
+    }
+}
+
+// 生成一行目标像素：两行源像素解码为浮点后纵向相加，再横向两两相加
+void downsampleRow(const unsigned char* src, int width, int height, int channels,
+    const float* const decode[4], const bool encodeSrgb[4], const GammaTables& tables,
+    unsigned char* dst, int dstWidth, int y) {
+    thread_local std::vector<float> rows, columnSums, sums;
+    thread_local std::vector<int> encoded, bytes;
+
+    size_t rowCount = (size_t)width * channels;
+    size_t dstCount = (size_t)dstWidth * channels;
+    rows.resize(rowCount * 2);
+    columnSums.resize(rowCount);
+    sums.resize(dstCount);
+    encoded.resize(dstCount);
+    bytes.resize(dstCount);
+
+    const unsigned char* row0 = src + (size_t)std::min(y * 2, height - 1) * rowCount;
+    const unsigned char* row1 = src + (size_t)std::min(y * 2 + 1, height - 1) * rowCount;
+    for (size_t i = 0; i < rowCount; i += channels) {
+        for (int c = 0; c < channels; c++) {
+            rows[i + c] = decode[c][row0[i + c]];
+            rows[rowCount + i + c] = decode[c][row1[i + c]];
+        }
+    }
+    addRows(rows.data(), rows.data() + rowCount, columnSums.data(), rowCount);
+
+    const float* column = columnSums.data();
+    for (int x = 0; x < dstWidth; x++) {
+        const float* p0 = column + (size_t)std::min(x * 2, width - 1) * channels;
+        const float* p1 = column + (size_t)std::min(x * 2 + 1, width - 1) * channels;
+        float* out = sums.data() + (size_t)x * channels;
+#ifdef MIP_GENERATOR_SSE2
+        if (channels == 4) {
+            _mm_storeu_ps(out, _mm_add_ps(_mm_loadu_ps(p0), _mm_loadu_ps(p1)));
+            continue;
+        }
+#endif
+        for (int c = 0; c < channels; c++) {
+            out[c] = p0[c] + p1[c];
+        }
+    }
+
+    quantize(sums.data(), encoded.data(), bytes.data(), dstCount);
+    for (size_t i = 0; i < dstCount; i += channels) {
+        for (int c = 0; c < channels; c++) {
+            dst[i + c] = encodeSrgb[c] ? tables.toSrgb[std::min(encoded[i + c], kEncodeSteps)]
+                : (unsigned char)std::min(bytes[i + c], 255);
+        }
+    }
+}
+
+} // namespace
+
+int getMipLevelCount(int width, int height) {
+    int levels = 1;
+    while (width > 1 || height > 1) {
+        width = std::max(1, width / 2);
+        height = std::max(1, height / 2);
+        levels++;
+    }
+    return levels;
+}
+
+void downsampleImage(const unsigned char* src, int width, int height, int channels, bool srgb,
+    std::vector<unsigned char>& dst) {
+    int dstWidth = std::max(1, width / 2);
+    int dstHeight = std::max(1, height / 2);
+    dst.resize((size_t)dstWidth * dstHeight * channels);
+
+    const GammaTables& tables = gammaTables();
+    const float* decode[4];
+    bool encodeSrgb[4];
+    channelTables(tables, channels, srgb, decode, encodeSrgb);
+
+    // 每个任务处理 kRowsPerTask 行，避免小尺寸 mip 级别的调度开销超过计算本身
+    const int kRowsPerTask = 16;
+    unsigned char* out = dst.data();
+    size_t tasks = (size_t)(dstHeight + kRowsPerTask - 1) / kRowsPerTask;
+    getThreadPool().parallelFor(tasks, [&](size_t task) {
+        int end = std::min(dstHeight, (int)(task + 1) * kRowsPerTask);
+        for (int y = (int)task * kRowsPerTask; y < end; y++) {
+            downsampleRow(src, width, height, channels, decode, encodeSrgb, tables,
+                out + (size_t)y * dstWidth * channels, dstWidth, y);
+        }
+    });
+}
+
+void generateMipChain(const unsigned char* pixels, int width, int height, int channels, bool srgb,
+    std::vector<std::vector<unsigned char>>& levels) {
+    int count = getMipLevelCount(width, height);
+    levels.assign(count - 1, std::vector<unsigned char>());
+
+    const unsigned char* src = pixels;
+    for (int level = 1; level < count; level++) {
+        downsampleImage(src, width, height, channels, srgb, levels[level - 1]);
+        src = levels[level - 1].data();
+        width = std::max(1, width / 2);
+        height = std::max(1, height / 2);
+    }
+}
+
+bool resizeImage(const unsigned char* src, int width, int height, int channels, bool srgb,
+    std::vector<unsigned char>& dst, int dstWidth, int dstHeight) {
+    dst.resize((size_t)dstWidth * dstHeight * channels);
+    int alphaChannel = (channels == 4) ? 3 : (channels == 2 ? 1 : STBIR_ALPHA_CHANNEL_NONE);
+    if (srgb && channels >= 3) {
+        return stbir_resize_uint8_srgb(src, width, height, 0, dst.data(), dstWidth, dstHeight, 0,
+            channels, alphaChannel, 0) != 0;
+    }
+    return stbir_resize_uint8(src, width, height, 0, dst.data(), dstWidth, dstHeight, 0, channels) != 0;
+}
@@ -0,0 +1,27 @@
+#ifndef MIP_GENERATOR_H
+#define MIP_GENERATOR_H
+
+#include <vector>
+#include <cstddef>
+
+// CPU mip 链生成：2x2 盒式滤波，颜色通道在线性空间平均（sRGB 解码 -> 平均 -> 编码），
+// alpha 及 1/2 通道图像按线性数据处理。逐行并行，SSE2 可用时向量化。
+// 结果与驱动无关，且可在工作线程中生成，上传时只需逐级拷贝
+
+// mip 级数（直到 1x1）
+int getMipLevelCount(int width, int height);
+
+// 生成下一级（dstWidth = max(1, width / 2)，dstHeight 同理），奇数边长时钳制到边缘
+void downsampleImage(const unsigned char* src, int width, int height, int channels, bool srgb,
+    std::vector<unsigned char>& dst);
+
+// 生成第 1 级起的全部 mip（不含第 0 级），levels[i] 为第 i + 1 级
+void generateMipChain(const unsigned char* pixels, int width, int height, int channels, bool srgb,
+    std::vector<std::vector<unsigned char>>& levels);
+
+// 任意尺寸重采样（stb_image_resize，Mitchell / 三次滤波），srgb 时颜色通道在线性空间滤波
+// 用于把同类纹理统一到纹理数组的层尺寸
+bool resizeImage(const unsigned char* src, int width, int height, int channels, bool srgb,
+    std::vector<unsigned char>& dst, int dstWidth, int dstHeight);
+
+#endif // MIP_GENERATOR_H
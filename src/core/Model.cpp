@@ -1,27 +1,535 @@
 #include "Model.h"
 #include "Texture.h"
+#include "MeshCache.h"
+#include "ObjLoader.h"
+#include "VirtualFileSystem.h"
+#include "ThreadPool.h"
+#include "../geometry/MeshOptimizer.h"
+#include "../geometry/VoxelMesher.h"
 #include <iostream>
 #include <sstream>
 #include <algorithm>
 #include <cstring>
 #include <climits>
+#include <cfloat>
 #include <fstream>
 #include <cstddef>
+#include <chrono>
+#include <cctype>
 
 #ifdef ASSIMP_AVAILABLE
-Model::Model(const std::string& path) : scaleFactor(1.0f) {
-    loadModel(path);
+#include <assimp/IOSystem.hpp>
+#include <assimp/IOStream.hpp>
+
+// Assimp 通过虚拟文件系统读取模型及其引用的 .mtl 等文件（资源包优先，其次为散文件）
+class VirtualIOStream : public Assimp::IOStream {
+public:
+    VirtualIOStream() : position(0) {}
+    VirtualFile file;
+
+    size_t Read(void* buffer, size_t size, size_t count) override {
+        if (size == 0) return 0;
+        size_t available = (file.size() - position) / size;
+        count = std::min(count, available);
+        std::memcpy(buffer, file.data() + position, size * count);
+        position += size * count;
+        return count;
+    }
+    size_t Write(const void*, size_t, size_t) override { return 0; }
+    aiReturn Seek(size_t offset, aiOrigin origin) override {
+        size_t base = (origin == aiOrigin_SET) ? 0 : (origin == aiOrigin_CUR ? position : file.size());
+        if (offset > file.size() - base) return aiReturn_FAILURE;
+        position = base + offset;
+        return aiReturn_SUCCESS;
+    }
+    size_t Tell() const override { return position; }
+    size_t FileSize() const override { return file.size(); }
+    void Flush() override {}
+
+private:
+    size_t position;
+};
+
+class VirtualIOSystem : public Assimp::IOSystem {
+public:
+    bool Exists(const char* path) const override { return virtualFileExists(path); }
+    char getOsSeparator() const override { return '/'; }
+    Assimp::IOStream* Open(const char* path, const char* mode) override {
+        if (std::strchr(mode, 'w') || std::strchr(mode, 'a')) return nullptr;
+        VirtualIOStream* stream = new VirtualIOStream();
+        if (!stream->file.open(path)) {
+            delete stream;
+            return nullptr;
+        }
+        return stream;
+    }
+    void Close(Assimp::IOStream* stream) override { delete stream; }
+};
+
+// 项目内附带的 assimp/config.h 是精简版本，不含 RemoveComponent 的配置项，
+// 这里按 Assimp 的定义补充（切线 / 顶点色 / 骨骼权重 / 动画 / 灯光 / 相机）
+#ifndef AI_CONFIG_PP_RVC_FLAGS
+#define AI_CONFIG_PP_RVC_FLAGS "PP_RVC_FLAGS"
+#endif
+static const int kRemovedComponents = 0x4 | 0x8 | 0x20 | 0x40 | 0x100 | 0x200;
+
+// 带透明贴图或不透明度小于 1 的材质（如树叶）不能剔除内部面
+static bool isOpaqueMaterial(const aiMaterial* material) {
+    if (material->GetTextureCount(aiTextureType_OPACITY) > 0) return false;
+    float opacity = 1.0f;
+    if (material->Get(AI_MATKEY_OPACITY, opacity) == AI_SUCCESS && opacity < 1.0f) return false;
+    return true;
+}
+#endif
+
+static double elapsedMilliseconds(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+struct Model::PreparedData {
+    // 冷加载：导入并处理后的网格
+    std::vector<MeshData> meshData;
+    std::vector<ModelMaterial> materials;
+    // 热加载：映射的 .meshcache，顶点 / 索引在上传时直接从映射内存读取
+    VirtualFile cacheFile;
+    MeshCacheView cacheView;
+    bool fromCache = false;
+    // 待上传的网格（指向 meshData 或映射内存）及其在工作线程上转换好的 GPU 数据
+    std::vector<MeshCacheMeshView> views;
+    std::vector<PackedMesh> packed;
+
+    const std::vector<ModelMaterial>& meshMaterials() const { return fromCache ? cacheView.materials : materials; }
+};
+
+Model::Model(const std::string& path, const ModelImportOptions& options)
+    : scaleFactor(1.0f), importOptions(options), boundingBoxMin(0.0f), boundingBoxMax(0.0f) {
+    prepareModel(path);
+    uploadPrepared();
+}
+
+Model::Model(const ModelImportOptions& options)
+    : scaleFactor(1.0f), importOptions(options), boundingBoxMin(0.0f), boundingBoxMax(0.0f) {}
+
+std::unique_ptr<Model> Model::prepare(const std::string& path, const ModelImportOptions& options) {
+    std::unique_ptr<Model> model(new Model(options));
+    model->prepareModel(path);
+    return model;
+}
+
+bool Model::cookMeshCache(const std::string& path, const ModelImportOptions& options) {
+    Model model(options);
+    std::vector<MeshData> meshData;
+    std::vector<ModelMaterial> materials;
+    if (!model.importMeshes(path, meshData, materials)) return false;
+    model.processMeshes(meshData, materials);
+    return writeMeshCache(path, model.cacheOptionsKey(), model.boundingBoxMin, model.boundingBoxMax,
+        model.scaleFactor, meshData, materials);
 }
 
-void Model::loadModel(const std::string& path) {
+void Model::prepareModel(const std::string& path) {
     std::cout << "[Model] Loading model from: " << path << std::endl;
-    
+    auto start = std::chrono::steady_clock::now();
+
+    directory = path.substr(0, path.find_last_of('/'));
+    if (directory.empty()) {
+        directory = path.substr(0, path.find_last_of('\\'));
+    }
+    if (directory.empty()) {
+        directory = ".";
+    }
+
+    // 热启动：直接映射上次导入的结果
+    if (importOptions.useMeshCache && loadFromCache(path)) {
+        packPreparedMeshes();
+        std::cout << "[Model] Warm load from mesh cache: " << elapsedMilliseconds(start) << " ms, meshes "
+            << prepared->views.size() << std::endl;
+        return;
+    }
+
+    auto data = std::make_shared<PreparedData>();
+    if (!importMeshes(path, data->meshData, data->materials)) {
+        return;
+    }
+
+    processMeshes(data->meshData, data->materials);
+
+    if (importOptions.useMeshCache) {
+        if (writeMeshCache(path, cacheOptionsKey(), boundingBoxMin, boundingBoxMax, scaleFactor, data->meshData, data->materials)) {
+            std::cout << "[Model] Mesh cache written: " << getMeshCachePath(path) << std::endl;
+        }
+    }
+    prepared = data;
+    packPreparedMeshes();
+    std::cout << "[Model] Cold load (import + processing): " << elapsedMilliseconds(start) << " ms" << std::endl;
+}
+
+// 收集非空网格并在线程池上并行转换为 GPU 格式（紧凑顶点、位置流、16 位索引）
+void Model::packPreparedMeshes() {
+    PreparedData& data = *prepared;
+    if (data.fromCache) {
+        for (const MeshCacheMeshView& view : data.cacheView.meshes) {
+            if (view.indexCount > 0) data.views.push_back(view);
+        }
+    } else {
+        for (const MeshData& mesh : data.meshData) {
+            if (mesh.indices.empty()) continue;
+            MeshCacheMeshView view;
+            view.vertices = mesh.vertices.data();
+            view.vertexCount = mesh.vertices.size();
+            view.indices = mesh.indices.data();
+            view.indexCount = mesh.indices.size();
+            view.meshlets = mesh.meshlets.data();
+            view.meshletCount = mesh.meshlets.size();
+            view.materialIndex = mesh.materialIndex;
+            view.atlasTiling = mesh.atlasTiling;
+            view.atlasTile = mesh.atlasTile;
+            data.views.push_back(view);
+        }
+    }
+
+    data.packed.resize(data.views.size());
+    residency.assign(data.views.size(), MeshResidency());
+    getThreadPool().parallelFor(data.views.size(), [&](size_t i) {
+        const MeshCacheMeshView& view = data.views[i];
+        data.packed[i] = packMesh(view.vertices, view.vertexCount, view.indices, view.indexCount,
+            importOptions.vertexFormat, importOptions.positionStream);
+
+        // 网格包围球（整网格剔除与延迟上传的可见性判断）
+        MeshResidency& record = residency[i];
+        if (view.vertexCount > 0) {
+            glm::vec3 boundsMin(view.vertices[0].Position), boundsMax(view.vertices[0].Position);
+            for (size_t v = 0; v < view.vertexCount; v++) {
+                boundsMin = glm::min(boundsMin, view.vertices[v].Position);
+                boundsMax = glm::max(boundsMax, view.vertices[v].Position);
+            }
+            record.center = (boundsMin + boundsMax) * 0.5f;
+            record.radius = glm::length(boundsMax - boundsMin) * 0.5f;
+        }
+    });
+}
+
+static size_t packedMeshBytes(const PackedMesh& packed) {
+    return packed.vertexData.size() + packed.positionData.size() + packed.indexData.size();
+}
+
+void Model::uploadPrepared() {
+    if (!prepared) return;
+    auto start = std::chrono::steady_clock::now();
+
+    // 材质纹理（注册表去重，异步解码）
+    const std::vector<ModelMaterial>& materials = prepared->meshMaterials();
+    for (const MeshCacheMeshView& view : prepared->views) {
+        if (view.materialIndex < materials.size()) {
+            loadMaterialTexture(materials[view.materialIndex]);
+        }
+    }
+
+    // 延迟上传：只建立网格记录（meshlet 与图集参数），缓冲在首次可见时创建，CPU 端数据保留
+    if (importOptions.lazyUpload) {
+        meshes.resize(prepared->views.size());
+        for (size_t i = 0; i < meshes.size(); i++) {
+            const MeshCacheMeshView& view = prepared->views[i];
+            meshes[i].meshlets.assign(view.meshlets, view.meshlets + view.meshletCount);
+            meshes[i].atlasTiling = view.atlasTiling;
+            meshes[i].atlasTile = view.atlasTile;
+        }
+        // 导入的模型只保留转换好的 GPU 数据（释放时也不丢弃），原始网格不再需要；
+        // 映射缓存的模型保留视图，释放后从映射内存重新转换
+        if (!prepared->fromCache) {
+            for (MeshCacheMeshView& view : prepared->views) {
+                view.vertices = nullptr;
+                view.indices = nullptr;
+                view.meshlets = nullptr;
+            }
+            std::vector<MeshData>().swap(prepared->meshData);
+        }
+        std::cout << "[Model] Deferred upload of " << meshes.size() << " meshes until first visible" << std::endl;
+        return;
+    }
+
+    // 所有网格一次批量上传
+    std::vector<Mesh> uploaded = uploadPackedMeshes(prepared->packed);
+    for (size_t i = 0; i < uploaded.size(); i++) {
+        const MeshCacheMeshView& view = prepared->views[i];
+        Mesh& mesh = uploaded[i];
+        mesh.meshlets.assign(view.meshlets, view.meshlets + view.meshletCount);
+        mesh.atlasTiling = view.atlasTiling;
+        mesh.atlasTile = view.atlasTile;
+        meshes.push_back(std::move(mesh));
+        residency[i].bytes = packedMeshBytes(prepared->packed[i]);
+    }
+    prepared.reset();
+
+    std::cout << "[Model] GPU upload: " << elapsedMilliseconds(start) << " ms, meshes " << meshes.size() << std::endl;
+}
+
+bool Model::ensureResident(size_t index) {
+    Mesh& mesh = meshes[index];
+    if (mesh.VAO != 0) return true;
+    if (!prepared || index >= prepared->packed.size()) return false;
+
+    // 从映射的缓存释放过的网格重新转换
+    PackedMesh& packed = prepared->packed[index];
+    if (packed.indexCount == 0) {
+        const MeshCacheMeshView& view = prepared->views[index];
+        if (view.vertices == nullptr) return false;
+        packed = packMesh(view.vertices, view.vertexCount, view.indices, view.indexCount,
+            importOptions.vertexFormat, importOptions.positionStream);
+    }
+
+    Mesh uploaded = uploadPackedMesh(packed);
+    uploaded.meshlets.swap(mesh.meshlets);
+    uploaded.atlasTiling = mesh.atlasTiling;
+    uploaded.atlasTile = mesh.atlasTile;
+    mesh = std::move(uploaded);
+    residency[index].bytes = packedMeshBytes(packed);
+    return mesh.VAO != 0;
+}
+
+bool Model::isWithinPrefetch(size_t index, const glm::mat4& model, const glm::vec3& cameraPos) const {
+    if (importOptions.prefetchRadius <= 0.0f) return false;
+    const MeshResidency& record = residency[index];
+    glm::vec3 worldCenter = glm::vec3(model * glm::vec4(record.center, 1.0f));
+    float scale = std::max({ glm::length(glm::vec3(model[0])), glm::length(glm::vec3(model[1])),
+        glm::length(glm::vec3(model[2])) });
+    return glm::length(worldCenter - cameraPos) - record.radius * scale <= importOptions.prefetchRadius;
+}
+
+size_t Model::releaseIdleMeshes(double timeoutSeconds) {
+    if (!importOptions.lazyUpload || !prepared) return 0;
+    auto now = std::chrono::steady_clock::now();
+    size_t released = 0, releasedBytes = 0;
+    for (size_t i = 0; i < meshes.size(); i++) {
+        if (meshes[i].VAO == 0) continue;
+        if (std::chrono::duration<double>(now - residency[i].lastVisible).count() <= timeoutSeconds) continue;
+        releaseMesh(meshes[i]);
+        releasedBytes += residency[i].bytes;
+        residency[i].bytes = 0;
+        // 映射的 .meshcache 即磁盘层，不再保留转换结果；导入的模型保留在内存中
+        if (prepared->fromCache) {
+            prepared->packed[i] = PackedMesh();
+        }
+        released++;
+    }
+    if (released > 0) {
+        std::cout << "[Model] Released " << released << " idle meshes (" << releasedBytes / 1024 << " KB)" << std::endl;
+    }
+    return released;
+}
+
+size_t Model::getResidentMeshCount() const {
+    size_t count = 0;
+    for (const Mesh& mesh : meshes) {
+        if (mesh.VAO != 0) count++;
+    }
+    return count;
+}
+
+size_t Model::getResidentMeshBytes() const {
+    size_t bytes = 0;
+    for (size_t i = 0; i < meshes.size() && i < residency.size(); i++) {
+        if (meshes[i].VAO != 0) bytes += residency[i].bytes;
+    }
+    return bytes;
+}
+
+size_t Model::getCpuMemoryBytes() const {
+    if (!prepared) return 0;
+    size_t bytes = 0;
+    for (const MeshData& data : prepared->meshData) {
+        bytes += data.vertices.size() * sizeof(Vertex) + data.indices.size() * sizeof(unsigned int)
+            + data.meshlets.size() * sizeof(Meshlet);
+    }
+    for (const PackedMesh& packed : prepared->packed) {
+        bytes += packedMeshBytes(packed);
+    }
+    return bytes;
+}
+
+size_t Model::getMappedCacheBytes() const {
+    return (prepared && prepared->fromCache) ? prepared->cacheFile.size() : 0;
+}
+
+uint32_t Model::cacheOptionsKey() const {
+    // 只有影响 CPU 端处理结果的选项参与缓存校验；顶点格式 / 位置流在上传时决定
+    return (importOptions.weldVertices ? 1u : 0u)
+        | (importOptions.mergeByMaterial ? 2u : 0u)
+        | (importOptions.voxelOptimize ? 4u : 0u)
+        | (importOptions.optimizeMeshes ? 8u : 0u)
+        | (importOptions.buildMeshlets ? 16u : 0u);
+}
+
+bool Model::loadFromCache(const std::string& path) {
+    auto data = std::make_shared<PreparedData>();
+    if (!readMeshCache(path, cacheOptionsKey(), data->cacheFile, data->cacheView)) {
+        return false;
+    }
+
+    boundingBoxMin = data->cacheView.boundsMin;
+    boundingBoxMax = data->cacheView.boundsMax;
+    scaleFactor = data->cacheView.scaleFactor;
+
+    // 上传前保持映射，顶点 / 索引直接从映射内存上传
+    data->fromCache = true;
+    prepared = data;
+    return true;
+}
+
+void Model::processMeshes(std::vector<MeshData>& meshData, const std::vector<ModelMaterial>& materials) {
+    // 导入前统计
+    size_t meshCountBefore = meshData.size();
+    size_t vertexCountBefore = 0;
+    size_t indexCountBefore = 0;
+    for (const MeshData& data : meshData) {
+        vertexCountBefore += data.vertices.size();
+        indexCountBefore += data.indices.size();
+    }
+
+    // 各网格互不依赖，在线程池上并行处理；日志按网格收集，处理完后按原顺序输出
+    // 体素模型：剔除内部面并贪心合并共面方块面（一个网格可能按图块拆分为多个）
+    if (importOptions.voxelOptimize) {
+        std::vector<std::vector<MeshData>> outputs(meshData.size());
+        std::vector<std::string> logs(meshData.size());
+        getThreadPool().parallelFor(meshData.size(), [&](size_t i) {
+            VoxelMeshStats stats;
+            bool opaque = materials[meshData[i].materialIndex].opaque;
+            if (optimizeVoxelMesh(meshData[i], opaque, outputs[i], stats)) {
+                std::ostringstream log;
+                log << "[Model] Voxel mesh (cell " << stats.cellSize << "): triangles "
+                    << stats.trianglesBefore << " -> " << stats.trianglesAfter
+                    << ", hidden faces removed " << stats.hiddenFacesRemoved << "\n";
+                logs[i] = log.str();
+            } else {
+                outputs[i].push_back(std::move(meshData[i]));
+            }
+        });
+
+        std::vector<MeshData> optimized;
+        for (size_t i = 0; i < outputs.size(); i++) {
+            std::cout << logs[i];
+            for (MeshData& data : outputs[i]) {
+                optimized.push_back(std::move(data));
+            }
+        }
+        meshData.swap(optimized);
+    }
+
+    std::vector<std::string> logs(meshData.size());
+    getThreadPool().parallelFor(meshData.size(), [&](size_t i) {
+        MeshData& data = meshData[i];
+        // 顶点焊接：合并属性完全相同的顶点
+        if (importOptions.weldVertices && !data.vertices.empty()) {
+            size_t uniqueCount = 0;
+            std::vector<unsigned int> remap = generateVertexRemap(data.vertices.data(),
+                data.vertices.size(), sizeof(Vertex), uniqueCount);
+            remapIndexBuffer(data.indices, remap);
+            remapVertexBuffer(data.vertices, remap, uniqueCount);
+        }
+
+        // 索引重排：顶点缓存 -> overdraw -> 顶点读取
+        if (importOptions.optimizeMeshes) {
+            std::ostringstream log;
+            optimizeMesh(data.vertices, data.indices, materials[data.materialIndex].name, log);
+            logs[i] = log.str();
+        }
+
+        if (importOptions.buildMeshlets) {
+            data.meshlets = buildMeshlets(data.vertices, data.indices);
+        }
+    });
+
+    size_t vertexCountAfter = 0;
+    size_t indexCountAfter = 0;
+    for (size_t i = 0; i < meshData.size(); i++) {
+        std::cout << logs[i];
+        vertexCountAfter += meshData[i].vertices.size();
+        indexCountAfter += meshData[i].indices.size();
+    }
+
+    std::cout << "[Model] Import stats: vertices " << vertexCountBefore << " -> " << vertexCountAfter
+        << ", indices " << indexCountBefore << " -> " << indexCountAfter
+        << ", meshes " << meshCountBefore << " -> " << meshData.size() << std::endl;
+}
+
+void Model::loadMaterialTexture(const ModelMaterial& material) {
+    if (material.diffusePath.empty()) return;
+
+    // 全局注册表负责跨模型去重，这里只避免同一模型重复记录
+    TextureHandle handle = TextureFromFile(material.diffusePath.c_str(), directory);
+    for (const Texture& loaded : textures_loaded) {
+        if (loaded.handle == handle) return;
+    }
+
+    Texture texture;
+    texture.id = handle->id;
+    texture.handle = handle;
+    texture.type = "texture_diffuse";
+    texture.path = material.diffusePath;
+    textures_loaded.push_back(texture);
+}
+
+static bool isObjFile(const std::string& path) {
+    size_t dot = path.find_last_of('.');
+    if (dot == std::string::npos) return false;
+    std::string extension = path.substr(dot + 1);
+    std::transform(extension.begin(), extension.end(), extension.begin(),
+        [](unsigned char c) { return (char)std::tolower(c); });
+    return extension == "obj";
+}
+
+bool Model::importMeshes(const std::string& path, std::vector<MeshData>& meshData,
+    std::vector<ModelMaterial>& materials) {
+#ifdef ASSIMP_AVAILABLE
+    if (!importOptions.nativeObjLoader || !isObjFile(path)) {
+        return importWithAssimp(path, meshData, materials);
+    }
+#endif
+    if (!isObjFile(path)) {
+        std::cerr << "ERROR: Assimp not available and no mesh cache found. Cannot load model: " << path << std::endl;
+        return false;
+    }
+    return importWithObjLoader(path, meshData, materials);
+}
+
+bool Model::importWithObjLoader(const std::string& path, std::vector<MeshData>& meshData,
+    std::vector<ModelMaterial>& materials) {
+    ObjScene scene;
+    if (!loadObj(path, scene)) {
+        std::cerr << "Failed to load model: " << path << std::endl;
+        return false;
+    }
+    std::cout << "[Model] OBJ parsed with native loader (" << scene.stats.threads << " threads): "
+        << scene.stats.positions << " positions, " << scene.stats.faces << " faces, "
+        << scene.materials.size() << " materials" << std::endl;
+
+    // 计算边界框并归一化
+    boundingBoxMin = scene.boundsMin;
+    boundingBoxMax = scene.boundsMax;
+    normalizeModel();
+
+    for (MeshData& data : scene.meshes) {
+        for (Vertex& vertex : data.vertices) {
+            vertex.Position *= scaleFactor;
+        }
+    }
+
+    meshData = std::move(scene.meshes);
+    materials = std::move(scene.materials);
+    return true;
+}
+
+#ifdef ASSIMP_AVAILABLE
+bool Model::importWithAssimp(const std::string& path, std::vector<MeshData>& meshData,
+    std::vector<ModelMaterial>& materials) {
     Assimp::Importer importer;
+    importer.SetIOHandler(new VirtualIOSystem()); // Importer 负责释放
+    // 只保留位置 / 法线 / 第一套纹理坐标，丢弃渲染不使用的属性流
+    importer.SetPropertyInteger(AI_CONFIG_PP_RVC_FLAGS, kRemovedComponents);
     const aiScene* scene = importer.ReadFile(path, 
         aiProcess_Triangulate | 
         aiProcess_GenSmoothNormals | 
         aiProcess_FlipUVs | 
-        aiProcess_CalcTangentSpace);
+        aiProcess_RemoveComponent);
 
     if (!scene || scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE || !scene->mRootNode) {
         std::cerr << "ERROR::ASSIMP:: " << importer.GetErrorString() << std::endl;
@@ -35,44 +543,36 @@ void Model::loadModel(const std::string& path) {
         if (scene && !scene->mRootNode) {
             std::cerr << "  Root node is null!" << std::endl;
         }
-        meshes.clear();
-        textures_loaded.clear();
-        return;
+        return false;
     }
     
     std::cout << "[Model] Scene loaded successfully. Meshes: " << scene->mNumMeshes << std::endl;
 
-    directory = path.substr(0, path.find_last_of('/'));
-    if (directory.empty()) {
-        directory = path.substr(0, path.find_last_of('\\'));
-    }
-    if (directory.empty()) {
-        directory = ".";
-    }
-
     // 计算边界框并归一化
     calculateBoundingBox(scene);
     normalizeModel();
 
-    processNode(scene->mRootNode, scene);
-    
-    std::cout << "[Model] Model processing complete. Total meshes: " << meshes.size() << std::endl;
-}
-#else
-Model::Model(const std::string& path) : scaleFactor(1.0f) {
-    std::cerr << "ERROR: Assimp not available. Cannot load model: " << path << std::endl;
-    meshes.clear();
-    textures_loaded.clear();
-}
+    // 材质：名称、第一张漫反射贴图、是否不透明
+    for (unsigned int i = 0; i < scene->mNumMaterials; i++) {
+        aiMaterial* aiMat = scene->mMaterials[i];
+        ModelMaterial material;
+        aiString name;
+        if (aiMat->Get(AI_MATKEY_NAME, name) == AI_SUCCESS) {
+            material.name = name.C_Str();
+        }
+        if (aiMat->GetTextureCount(aiTextureType_DIFFUSE) > 0) {
+            aiString texturePath;
+            aiMat->GetTexture(aiTextureType_DIFFUSE, 0, &texturePath);
+            material.diffusePath = texturePath.C_Str();
+        }
+        material.opaque = isOpaqueMaterial(aiMat);
+        materials.push_back(material);
+    }
 
-void Model::loadModel(const std::string& path) {
-    std::cerr << "ERROR: Assimp not available. Cannot load model: " << path << std::endl;
-    meshes.clear();
-    textures_loaded.clear();
+    convertMeshes(scene, meshData);
+    return true;
 }
-#endif
 
-#ifdef ASSIMP_AVAILABLE
 void Model::calculateBoundingBox(const aiScene* scene) {
     boundingBoxMin = glm::vec3(FLT_MAX);
     boundingBoxMax = glm::vec3(-FLT_MAX);
@@ -93,170 +593,139 @@ void Model::calculateBoundingBox(const aiScene* scene) {
         }
     }
 }
-#endif
-
-void Model::normalizeModel() {
-#ifdef ASSIMP_AVAILABLE
-    glm::vec3 size = boundingBoxMax - boundingBoxMin;
-    float maxSize = std::max({size.x, size.y, size.z});
-    
-    if (maxSize > 0.0f) {
-        // 归一化到 [-1, 1] 范围，然后可以按需缩放
-        scaleFactor = 2.0f / maxSize;
-    } else {
-        scaleFactor = 1.0f;
-    }
-#else
-    scaleFactor = 1.0f;
-#endif
-}
 
-#ifdef ASSIMP_AVAILABLE
-void Model::processNode(aiNode* node, const aiScene* scene) {
-    for (unsigned int i = 0; i < node->mNumMeshes; i++) {
-        aiMesh* mesh = scene->mMeshes[node->mMeshes[i]];
-        Mesh processedMesh = processMesh(mesh, scene);
-        if (processedMesh.indexCount > 0) {
-            meshes.push_back(processedMesh);
+// 转换一个 Assimp 网格到预分配的顶点 / 索引区间（位置应用缩放，索引加上在合并网格中的顶点偏移）
+static void convertMesh(const aiMesh* mesh, float scale, Vertex* vertices, unsigned int* indices, unsigned int baseVertex) {
+    bool hasNormals = mesh->HasNormals();
+    const aiVector3D* texCoords = mesh->mTextureCoords[0];
+    for (unsigned int i = 0; i < mesh->mNumVertices; i++) {
+        Vertex& vertex = vertices[i];
+        const aiVector3D& position = mesh->mVertices[i];
+        vertex.Position = glm::vec3(position.x, position.y, position.z) * scale;
+        if (hasNormals) {
+            const aiVector3D& normal = mesh->mNormals[i];
+            vertex.Normal = glm::vec3(normal.x, normal.y, normal.z);
+        } else {
+            vertex.Normal = glm::vec3(0.0f, 1.0f, 0.0f);
         }
+        vertex.TexCoords = texCoords ? glm::vec2(texCoords[i].x, texCoords[i].y) : glm::vec2(0.0f);
     }
 
-    for (unsigned int i = 0; i < node->mNumChildren; i++) {
-        processNode(node->mChildren[i], scene);
+    for (unsigned int i = 0; i < mesh->mNumFaces; i++) {
+        const aiFace& face = mesh->mFaces[i];
+        for (unsigned int j = 0; j < face.mNumIndices; j++) {
+            *indices++ = baseVertex + face.mIndices[j];
+        }
     }
 }
 
-Mesh Model::processMesh(aiMesh* mesh, const aiScene* scene) {
-    std::vector<Vertex> vertices;
-    std::vector<unsigned int> indices;
-    std::vector<Texture> textures;
+void Model::convertMeshes(const aiScene* scene, std::vector<MeshData>& meshData) {
+    // 网格实例在合并后 MeshData 中的位置
+    struct MeshSlot {
+        const aiMesh* mesh;
+        size_t target;
+        size_t vertexOffset;
+        size_t indexOffset;
+    };
 
-    // 处理顶点
-    for (unsigned int i = 0; i < mesh->mNumVertices; i++) {
-        Vertex vertex;
-        
-        // 位置（应用缩放）
-        glm::vec3 vector;
-        vector.x = mesh->mVertices[i].x * scaleFactor;
-        vector.y = mesh->mVertices[i].y * scaleFactor;
-        vector.z = mesh->mVertices[i].z * scaleFactor;
-        vertex.Position = vector;
-
-        // 法线
-        if (mesh->HasNormals()) {
-            vector.x = mesh->mNormals[i].x;
-            vector.y = mesh->mNormals[i].y;
-            vector.z = mesh->mNormals[i].z;
-            vertex.Normal = vector;
-        } else {
-            vertex.Normal = glm::vec3(0.0f, 1.0f, 0.0f);
+    // 按节点树先序（显式栈，子节点逆序入栈）收集网格实例；共享材质的网格合并到同一个 MeshData
+    std::vector<MeshSlot> slots;
+    std::vector<const aiNode*> stack = { scene->mRootNode };
+    while (!stack.empty()) {
+        const aiNode* node = stack.back();
+        stack.pop_back();
+        for (unsigned int i = 0; i < node->mNumMeshes; i++) {
+            const aiMesh* mesh = scene->mMeshes[node->mMeshes[i]];
+            size_t target = meshData.size();
+            if (importOptions.mergeByMaterial) {
+                for (size_t j = 0; j < meshData.size(); j++) {
+                    if (meshData[j].materialIndex == mesh->mMaterialIndex) {
+                        target = j;
+                        break;
+                    }
+                }
+            }
+            if (target == meshData.size()) {
+                meshData.emplace_back();
+                meshData.back().materialIndex = mesh->mMaterialIndex;
+            }
+            slots.push_back({ mesh, target, 0, 0 });
         }
-
-        // 纹理坐标
-        if (mesh->mTextureCoords[0]) {
-            glm::vec2 vec;
-            vec.x = mesh->mTextureCoords[0][i].x;
-            vec.y = mesh->mTextureCoords[0][i].y;
-            vertex.TexCoords = vec;
-        } else {
-            vertex.TexCoords = glm::vec2(0.0f, 0.0f);
+        for (unsigned int i = node->mNumChildren; i-- > 0;) {
+            stack.push_back(node->mChildren[i]);
         }
-
-        vertices.push_back(vertex);
     }
 
-    // 处理索引
-    for (unsigned int i = 0; i < mesh->mNumFaces; i++) {
-        aiFace face = mesh->mFaces[i];
-        for (unsigned int j = 0; j < face.mNumIndices; j++) {
-            indices.push_back(face.mIndices[j]);
+    // 各网格的索引数（三角化后一般为面数的 3 倍，点 / 线图元更少）
+    std::vector<size_t> indexCounts(slots.size());
+    getThreadPool().parallelFor(slots.size(), [&](size_t i) {
+        size_t count = 0;
+        for (unsigned int f = 0; f < slots[i].mesh->mNumFaces; f++) {
+            count += slots[i].mesh->mFaces[f].mNumIndices;
         }
-    }
+        indexCounts[i] = count;
+    });
 
-    // 处理材质
-    if (mesh->mMaterialIndex >= 0) {
-        aiMaterial* material = scene->mMaterials[mesh->mMaterialIndex];
-        
-        std::vector<Texture> diffuseMaps = loadMaterialTextures(material, 
-            aiTextureType_DIFFUSE, "texture_diffuse");
-        textures.insert(textures.end(), diffuseMaps.begin(), diffuseMaps.end());
+    // 计算偏移并一次性分配，之后各网格并行写入互不重叠的区间
+    std::vector<size_t> vertexTotals(meshData.size(), 0);
+    std::vector<size_t> indexTotals(meshData.size(), 0);
+    for (size_t i = 0; i < slots.size(); i++) {
+        MeshSlot& slot = slots[i];
+        slot.vertexOffset = vertexTotals[slot.target];
+        slot.indexOffset = indexTotals[slot.target];
+        vertexTotals[slot.target] += slot.mesh->mNumVertices;
+        indexTotals[slot.target] += indexCounts[i];
+    }
+    for (size_t t = 0; t < meshData.size(); t++) {
+        meshData[t].vertices.resize(vertexTotals[t]);
+        meshData[t].indices.resize(indexTotals[t]);
     }
 
-    // 创建 Mesh 对象
-    Mesh result;
-    
-    glGenVertexArrays(1, &result.VAO);
-    glGenBuffers(1, &result.VBO);
-    glGenBuffers(1, &result.EBO);
+    getThreadPool().parallelFor(slots.size(), [&](size_t i) {
+        const MeshSlot& slot = slots[i];
+        MeshData& target = meshData[slot.target];
+        convertMesh(slot.mesh, scaleFactor, target.vertices.data() + slot.vertexOffset,
+            target.indices.data() + slot.indexOffset, (unsigned int)slot.vertexOffset);
+    });
+}
 
-    glBindVertexArray(result.VAO);
+#endif
 
-    glBindBuffer(GL_ARRAY_BUFFER, result.VBO);
-    glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(Vertex), 
-        &vertices[0], GL_STATIC_DRAW);
+void Model::normalizeModel() {
+    glm::vec3 size = boundingBoxMax - boundingBoxMin;
+    float maxSize = std::max({size.x, size.y, size.z});
+    
+    if (maxSize > 0.0f) {
+        // 归一化到 [-1, 1] 范围，然后可以按需缩放
+        scaleFactor = 2.0f / maxSize;
+    } else {
+        scaleFactor = 1.0f;
+    }
+}
 
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, result.EBO);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(unsigned int), 
-        &indices[0], GL_STATIC_DRAW);
+void Model::optimizeMesh(std::vector<Vertex>& vertices, std::vector<unsigned int>& indices,
+    const std::string& name, std::ostream& log) const {
+    if (indices.empty()) return;
 
-    // 顶点位置
-    glEnableVertexAttribArray(0);
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)0);
-    
-    // 法线
-    glEnableVertexAttribArray(1);
-    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), 
-        (void*)offsetof(Vertex, Normal));
-    
-    // 纹理坐标
-    glEnableVertexAttribArray(2);
-    glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), 
-        (void*)offsetof(Vertex, TexCoords));
+    VertexCacheStats before = analyzeVertexCache(indices, vertices.size());
 
-    glBindVertexArray(0);
+    std::vector<unsigned int> clusters;
+    optimizeVertexCache(indices, vertices.size(), 16, &clusters);
+    optimizeOverdraw(indices, clusters, &vertices[0].Position.x, vertices.size(),
+        sizeof(Vertex) / sizeof(float));
 
-    result.indexCount = indices.size();
-    
-    // 存储纹理信息（简化处理，只使用第一个纹理）
-    if (!textures.empty()) {
-        // 纹理 ID 可以通过 shader 设置，这里我们只存储引用
-    }
+    size_t newVertexCount = 0;
+    std::vector<unsigned int> remap = optimizeVertexFetch(indices, vertices.size(), newVertexCount);
+    remapVertexBuffer(vertices, remap, newVertexCount);
 
-    return result;
-}
+    VertexCacheStats after = analyzeVertexCache(indices, vertices.size());
 
-std::vector<Texture> Model::loadMaterialTextures(aiMaterial* mat, 
-    aiTextureType type, const std::string& typeName) {
-    std::vector<Texture> textures;
-    
-    for (unsigned int i = 0; i < mat->GetTextureCount(type); i++) {
-        aiString str;
-        mat->GetTexture(type, i, &str);
-        
-        bool skip = false;
-        for (unsigned int j = 0; j < textures_loaded.size(); j++) {
-            if (std::strcmp(textures_loaded[j].path.data(), str.C_Str()) == 0) {
-                textures.push_back(textures_loaded[j]);
-                skip = true;
-                break;
-            }
-        }
-        
-        if (!skip) {
-            Texture texture;
-            texture.id = TextureFromFile(str.C_Str(), directory);
-            texture.type = typeName;
-            texture.path = str.C_Str();
-            textures.push_back(texture);
-            textures_loaded.push_back(texture);
-        }
-    }
-    
-    return textures;
+    log << "[Model] Optimized mesh '" << name << "' (" << indices.size() / 3 << " triangles): "
+        << "ACMR " << before.acmr << " -> " << after.acmr
+        << ", ATVR " << before.atvr << " -> " << after.atvr << "\n";
 }
-#endif
 
-unsigned int Model::TextureFromFile(const char* path, const std::string& directory) {
+TextureHandle Model::TextureFromFile(const char* path, const std::string& directory) {
     std::string filename = std::string(path);
     
     // 处理相对路径和绝对路径
@@ -282,18 +751,119 @@ unsigned int Model::TextureFromFile(const char* path, const std::string& directo
         std::replace(fullPath.begin(), fullPath.end(), '\\', '/');
     }
     
-    return loadTexture(fullPath.c_str());
+    return acquireTexture(fullPath);
 }
 
-void Model::Draw(const Shader& shader) const {
+void Model::bindMeshState(const Shader& shader, const Mesh& mesh) const {
+    // 紧凑顶点格式需要在顶点着色器中解码位置
+    shader.setBool("compactVertex", mesh.compact);
+    if (mesh.compact) {
+        shader.setVec3("positionOffset", mesh.positionOffset);
+        shader.setVec3("positionScale", mesh.positionScale);
+    }
+    // 体素合并面在图集图块内重复采样
+    shader.setBool("atlasTiling", mesh.atlasTiling);
+    if (mesh.atlasTiling) {
+        shader.setVec4("atlasTile", mesh.atlasTile);
+    }
+}
+
+void Model::resetMeshState(const Shader& shader) const {
+    shader.setBool("compactVertex", false);
+    shader.setBool("atlasTiling", false);
+}
+
+void Model::Draw(const Shader& shader) {
+    auto now = std::chrono::steady_clock::now();
     for (unsigned int i = 0; i < meshes.size(); i++) {
+        // 不做剔除的绘制：所有网格都视为可见
+        if (importOptions.lazyUpload) {
+            residency[i].lastVisible = now;
+            if (!ensureResident(i)) continue;
+        }
+        bindMeshState(shader, meshes[i]);
         glBindVertexArray(meshes[i].VAO);
-        glDrawElements(GL_TRIANGLES, meshes[i].indexCount, GL_UNSIGNED_INT, 0);
+        glDrawElements(GL_TRIANGLES, meshes[i].indexCount, meshes[i].indexType, 0);
         glBindVertexArray(0);
     }
+    resetMeshState(shader);
+}
+
+void Model::DrawCulled(const Shader& shader, const glm::mat4& model, const glm::mat4& viewProj,
+    const glm::vec3& cameraPos, MeshletCullStats* stats) {
+    submitCulled(shader, model, viewProj, cameraPos, stats, false);
+}
+
+void Model::DrawDepth(const Shader& depthShader, const glm::mat4& model, const glm::mat4& viewProj,
+    const glm::vec3& cameraPos) {
+    submitCulled(depthShader, model, viewProj, cameraPos, nullptr, true);
+}
+
+void Model::submitCulled(const Shader& shader, const glm::mat4& model, const glm::mat4& viewProj,
+    const glm::vec3& cameraPos, MeshletCullStats* stats, bool depthOnly) {
+    shader.setMat4("model", model);
+
+    // 在模型空间中剔除：视锥由 proj * view * model 提取，相机位置变换到模型空间
+    CullingFrustum frustum = extractFrustum(viewProj * model);
+    glm::vec3 localCamera = glm::vec3(glm::inverse(model) * glm::vec4(cameraPos, 1.0f));
+
+    std::vector<GLsizei> counts;
+    std::vector<const void*> offsets;
+
+    auto now = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < meshes.size(); i++) {
+        // 整网格包围球剔除；延迟上传时可见或在预取半径内的网格在此首次上传
+        bool visible = isSphereInFrustum(residency[i].center, residency[i].radius, frustum);
+        if (importOptions.lazyUpload && (visible || isWithinPrefetch(i, model, cameraPos))) {
+            residency[i].lastVisible = now;
+            ensureResident(i);
+        }
+        const Mesh& mesh = meshes[i];
+        if (!visible || mesh.VAO == 0) {
+            if (stats) stats->total += mesh.meshlets.size();
+            continue;
+        }
+
+        bindMeshState(shader, mesh);
+        if (depthOnly) {
+            bindDepthVertexArray(mesh); // 仅位置流
+        } else {
+            glBindVertexArray(mesh.VAO);
+        }
+
+        if (mesh.meshlets.empty()) {
+            glDrawElements(GL_TRIANGLES, mesh.indexCount, mesh.indexType, 0);
+            continue;
+        }
+
+        size_t indexSize = (mesh.indexType == GL_UNSIGNED_SHORT) ? sizeof(unsigned short) : sizeof(unsigned int);
+        counts.clear();
+        offsets.clear();
+        size_t runEnd = 0;
+        for (const Meshlet& meshlet : mesh.meshlets) {
+            if (!isMeshletVisible(meshlet, frustum, localCamera)) continue;
+            // 合并索引上相邻的可见 meshlet，减少 multi-draw 的条目数
+            if (!counts.empty() && runEnd == meshlet.indexOffset) {
+                counts.back() += meshlet.indexCount;
+            } else {
+                counts.push_back(meshlet.indexCount);
+                offsets.push_back((const void*)(meshlet.indexOffset * indexSize));
+            }
+            runEnd = meshlet.indexOffset + meshlet.indexCount;
+            if (stats) stats->visible++;
+        }
+        if (stats) stats->total += mesh.meshlets.size();
+
+        if (!counts.empty()) {
+            glMultiDrawElements(GL_TRIANGLES, counts.data(), mesh.indexType, offsets.data(), (GLsizei)counts.size());
+        }
+    }
+
+    glBindVertexArray(0);
+    resetMeshState(shader);
 }
 
-void Model::DrawInstanced(const Shader& shader, const std::vector<glm::mat4>& modelMatrices) const {
+void Model::DrawInstanced(const Shader& shader, const std::vector<glm::mat4>& modelMatrices) {
     // 简化版本：循环绘制每个实例
     for (const auto& modelMatrix : modelMatrices) {
         shader.setMat4("model", modelMatrix);
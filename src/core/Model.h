@@ -6,8 +6,13 @@
 #include <glm/gtc/matrix_transform.hpp>
 #include <string>
 #include <vector>
+#include <memory>
+#include <ostream>
+#include <chrono>
 #include "../geometry/Mesh.h"
 #include "Shader.h"
+#include "TextureRegistry.h"
+#include <cstdint>
 
 #ifdef ASSIMP_AVAILABLE
 #include <assimp/Importer.hpp>
@@ -22,19 +27,36 @@ struct aiScene;
 struct aiNode;
 struct aiMesh;
 struct aiMaterial;
-enum aiTextureType;
 #endif
 
-struct Vertex {
-    glm::vec3 Position;
-    glm::vec3 Normal;
-    glm::vec2 TexCoords;
+// meshlet 剔除统计
+struct MeshletCullStats {
+    size_t total = 0;
+    size_t visible = 0;
 };
 
+// 模型导入选项
+struct ModelImportOptions {
+    bool weldVertices = true;    // 导入时按属性哈希合并重复顶点
+    bool mergeByMaterial = true; // 合并共享材质的网格
+    bool voxelOptimize = true;   // 体素模型（Mineways 方块面）的内部面剔除与贪心合并
+    bool optimizeMeshes = true; // 导入时进行顶点缓存 / overdraw / 顶点读取顺序优化
+    bool buildMeshlets = true;  // 划分 meshlet 以支持 CPU 视锥 / 背面簇剔除
+    VertexFormat vertexFormat = VertexFormat::Float32; // GPU 顶点格式（Compact 约为一半显存）
+    bool positionStream = false; // 额外上传仅位置流，供 DrawDepth 使用
+    bool useMeshCache = true;    // 导入结果写入 <模型>.meshcache，之后启动直接映射
+    bool nativeObjLoader = false; // .obj 使用内置多线程加载器（没有 Assimp 时总是使用）
+    bool lazyUpload = false;      // 网格在剔除首次判定可见时才上传，闲置超时后释放显存（见 releaseIdleMeshes）
+    float prefetchRadius = 0.0f;  // 延迟上传：相机与网格包围球的距离（世界单位）小于该值时提前上传
+};
+
+struct MeshCacheMeshView;
+
 struct Texture {
     unsigned int id;
     std::string type;
     std::string path;
+    TextureHandle handle; // 注册表共享句柄，模型销毁时释放引用
 };
 
 class Model {
@@ -44,25 +66,78 @@ public:
     std::string directory;
     float scaleFactor; // 模型缩放因子
 
-    Model(const std::string& path);
-    void Draw(const Shader& shader) const;
-    void DrawInstanced(const Shader& shader, const std::vector<glm::mat4>& modelMatrices) const;
+    Model(const std::string& path, const ModelImportOptions& options = ModelImportOptions());
+    // 两阶段加载（异步加载用）：prepare 只读取文件并做 CPU 处理、不调用 GL，可在工作线程执行；
+    // uploadPrepared 在 GL 线程创建网格缓冲并请求纹理。构造函数依次执行两者
+    static std::unique_ptr<Model> prepare(const std::string& path, const ModelImportOptions& options = ModelImportOptions());
+    void uploadPrepared();
+    // 离线烘焙（asset_cook）：导入、处理并写入 .meshcache，不创建任何 GL 对象
+    static bool cookMeshCache(const std::string& path, const ModelImportOptions& options = ModelImportOptions());
+    // 绘制函数在延迟上传模式下会上传首次需要的网格，因此不是 const
+    void Draw(const Shader& shader);
+    void DrawInstanced(const Shader& shader, const std::vector<glm::mat4>& modelMatrices);
+    // 逐网格包围球 + 逐 meshlet 剔除后用 multi-draw 绘制；会设置 shader 的 model 矩阵
+    void DrawCulled(const Shader& shader, const glm::mat4& model, const glm::mat4& viewProj,
+        const glm::vec3& cameraPos, MeshletCullStats* stats = nullptr);
+    // 深度 pass：同样做剔除，但只绑定位置流（没有位置流时退回完整 VAO）
+    void DrawDepth(const Shader& depthShader, const glm::mat4& model, const glm::mat4& viewProj,
+        const glm::vec3& cameraPos);
+    // 延迟上传：释放超过 timeoutSeconds 未被判定可见的网格显存，数据回到内存（导入的模型）
+    // 或映射的 .meshcache（再次可见时从映射内存重新转换）；每帧调用，返回释放的网格数
+    size_t releaseIdleMeshes(double timeoutSeconds);
+    size_t getResidentMeshCount() const;
+    size_t getResidentMeshBytes() const;
+    // 延迟上传保留的 CPU 端数据（导入的网格与转换好的 GPU 数据）；映射的 .meshcache 单独统计（页缓存，可回收）
+    size_t getCpuMemoryBytes() const;
+    size_t getMappedCacheBytes() const;
     glm::vec3 getBoundingBoxMin() const { return boundingBoxMin; }
     glm::vec3 getBoundingBoxMax() const { return boundingBoxMax; }
 
 private:
+    explicit Model(const ModelImportOptions& options);
+
+    struct PreparedData; // CPU 阶段的结果（处理后的网格或映射的 .meshcache），上传后释放；延迟上传时保留
+
+    // 与 meshes 一一对应：模型空间包围球、GPU 数据大小与最近一次可见的时间
+    struct MeshResidency {
+        glm::vec3 center = glm::vec3(0.0f);
+        float radius = 0.0f;
+        size_t bytes = 0;
+        std::chrono::steady_clock::time_point lastVisible;
+    };
+
+    ModelImportOptions importOptions;
     glm::vec3 boundingBoxMin;
     glm::vec3 boundingBoxMax;
+    std::shared_ptr<PreparedData> prepared;
+    std::vector<MeshResidency> residency;
     
-    void loadModel(const std::string& path);
+    void prepareModel(const std::string& path);
+    bool loadFromCache(const std::string& path);
+    uint32_t cacheOptionsKey() const;
+    // 导入器：输出未处理的网格（已按 scaleFactor 缩放）与材质，并计算边界框
+    bool importMeshes(const std::string& path, std::vector<MeshData>& meshData, std::vector<ModelMaterial>& materials);
+    // 与导入器无关的 CPU 处理：体素合并、焊接、索引优化、meshlet 划分
+    void processMeshes(std::vector<MeshData>& meshData, const std::vector<ModelMaterial>& materials);
+    void packPreparedMeshes();
+    void loadMaterialTexture(const ModelMaterial& material);
+    bool importWithObjLoader(const std::string& path, std::vector<MeshData>& meshData, std::vector<ModelMaterial>& materials);
 #ifdef ASSIMP_AVAILABLE
-    void processNode(aiNode* node, const aiScene* scene);
-    Mesh processMesh(aiMesh* mesh, const aiScene* scene);
-    std::vector<Texture> loadMaterialTextures(aiMaterial* mat, aiTextureType type, const std::string& typeName);
+    bool importWithAssimp(const std::string& path, std::vector<MeshData>& meshData, std::vector<ModelMaterial>& materials);
+    // 收集节点树中的网格，预分配合并后的顶点 / 索引数组，再并行转换各网格
+    void convertMeshes(const aiScene* scene, std::vector<MeshData>& meshData);
     void calculateBoundingBox(const aiScene* scene);
 #endif
-    unsigned int TextureFromFile(const char* path, const std::string& directory);
+    TextureHandle TextureFromFile(const char* path, const std::string& directory);
     void normalizeModel();
+    void bindMeshState(const Shader& shader, const Mesh& mesh) const;
+    void resetMeshState(const Shader& shader) const;
+    void submitCulled(const Shader& shader, const glm::mat4& model, const glm::mat4& viewProj,
+        const glm::vec3& cameraPos, MeshletCullStats* stats, bool depthOnly);
+    bool ensureResident(size_t index);
+    bool isWithinPrefetch(size_t index, const glm::mat4& model, const glm::vec3& cameraPos) const;
+    void optimizeMesh(std::vector<Vertex>& vertices, std::vector<unsigned int>& indices, const std::string& name,
+        std::ostream& log) const;
 };
 
 #endif // MODEL_H
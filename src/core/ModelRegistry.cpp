@@ -0,0 +1,183 @@
+#include "ModelRegistry.h"
+#include "TextureRegistry.h"
+#include <iostream>
+#include <unordered_map>
+
+namespace {
+
+struct RegistryState {
+    std::unordered_map<std::string, std::weak_ptr<ModelResource>> entries;
+    bool shutDown = false;
+};
+
+RegistryState& registryState() {
+    static RegistryState state;
+    return state;
+}
+
+// 影响导入结果或 GPU 数据的全部选项都参与去重键
+std::string optionsKey(const ModelImportOptions& options) {
+    std::string key = "|";
+    key += options.weldVertices ? "w" : "-";
+    key += options.mergeByMaterial ? "m" : "-";
+    key += options.voxelOptimize ? "v" : "-";
+    key += options.optimizeMeshes ? "o" : "-";
+    key += options.buildMeshlets ? "l" : "-";
+    key += options.vertexFormat == VertexFormat::Compact ? "c" : "f";
+    key += options.positionStream ? "p" : "-";
+    key += options.useMeshCache ? "k" : "-";
+    key += options.nativeObjLoader ? "n" : "-";
+    key += options.lazyUpload ? "z" + std::to_string(options.prefetchRadius) : "-";
+    return key;
+}
+
+void releaseModelBuffers(Model& model) {
+    for (Mesh& mesh : model.meshes) {
+        releaseMesh(mesh);
+    }
+}
+
+void startLoad(ModelResource& resource) {
+    resource.pending = loadModelAsync(resource.sourcePath, resource.options);
+    if (!resource.model) {
+        resource.status = ModelAssetStatus::Loading;
+    }
+}
+
+} // namespace
+
+ModelResource::ModelResource(const std::string& key, const std::string& path, const std::string& sourcePath,
+    const ModelImportOptions& options)
+    : key(key), path(path), sourcePath(sourcePath), options(options) {}
+
+ModelResource::~ModelResource() {
+    RegistryState& state = registryState();
+    auto it = state.entries.find(key);
+    if (it != state.entries.end() && it->second.expired()) {
+        state.entries.erase(it);
+    }
+    // 仍在加载的任务由工作线程完成后释放（CPU 阶段不创建 GL 对象）
+    if (model && !state.shutDown) {
+        releaseModelBuffers(*model);
+    }
+}
+
+ModelHandle acquireModel(const std::string& path, const ModelImportOptions& options) {
+    RegistryState& state = registryState();
+    std::string normalized = normalizeTexturePath(path);
+    std::string key = normalized + optionsKey(options);
+
+    auto it = state.entries.find(key);
+    if (it != state.entries.end()) {
+        if (ModelHandle existing = it->second.lock()) {
+            if (existing->status == ModelAssetStatus::Unloaded) {
+                startLoad(*existing);
+            }
+            return existing;
+        }
+    }
+
+    ModelHandle handle = std::make_shared<ModelResource>(key, normalized, path, options);
+    startLoad(*handle);
+    state.entries[key] = handle;
+    return handle;
+}
+
+void processModelLoads() {
+    for (const ModelHandle& handle : getLiveModels()) {
+        ModelResource& resource = *handle;
+        if (!resource.pending) continue;
+
+        ModelLoadStatus status = pollModelLoad(resource.pending);
+        if (status == ModelLoadStatus::Loading) continue;
+
+        if (status == ModelLoadStatus::Ready) {
+            // 重新加载：新模型就绪后才释放旧模型，避免中间帧缺失
+            if (resource.model) {
+                releaseModelBuffers(*resource.model);
+            }
+            resource.model = takeLoadedModel(resource.pending);
+            resource.status = ModelAssetStatus::Ready;
+            resource.generation++;
+        } else {
+            std::cerr << "[ModelRegistry] Failed to load " << resource.path
+                << (resource.model ? ", keeping the previous version" : "") << std::endl;
+            resource.status = resource.model ? ModelAssetStatus::Ready : ModelAssetStatus::Failed;
+        }
+        resource.pending.reset();
+    }
+}
+
+void unloadModel(const ModelHandle& handle) {
+    if (!handle) return;
+    handle->pending.reset();
+    if (handle->model) {
+        size_t bytes = handle->model->getResidentMeshBytes() + handle->model->getCpuMemoryBytes();
+        releaseModelBuffers(*handle->model);
+        handle->model.reset();
+        std::cout << "[ModelRegistry] Unloaded " << handle->path << " (" << bytes / 1024 << " KB)" << std::endl;
+    }
+    handle->status = ModelAssetStatus::Unloaded;
+}
+
+void reloadModel(const ModelHandle& handle) {
+    if (!handle || handle->pending) return;
+    std::cout << "[ModelRegistry] Reloading " << handle->path << std::endl;
+    startLoad(*handle);
+}
+
+std::vector<ModelHandle> getLiveModels() {
+    RegistryState& state = registryState();
+    std::vector<ModelHandle> live;
+    for (auto& entry : state.entries) {
+        if (ModelHandle handle = entry.second.lock()) {
+            live.push_back(handle);
+        }
+    }
+    return live;
+}
+
+std::vector<ModelRecord> getModelRecords() {
+    std::vector<ModelHandle> live = getLiveModels();
+    std::vector<ModelRecord> records;
+    for (const ModelHandle& handle : live) {
+        ModelRecord record;
+        record.path = handle->path;
+        record.references = handle.use_count() - 1; // 不计本函数持有的引用
+        record.status = handle->status;
+        if (const Model* model = handle->get()) {
+            record.meshes = model->meshes.size();
+            record.residentMeshes = model->getResidentMeshCount();
+            record.gpuBytes = model->getResidentMeshBytes();
+            record.cpuBytes = model->getCpuMemoryBytes();
+            record.mappedBytes = model->getMappedCacheBytes();
+            record.textures = model->textures_loaded.size();
+        }
+        records.push_back(record);
+    }
+    return records;
+}
+
+const char* getModelAssetStatusName(ModelAssetStatus status) {
+    switch (status) {
+    case ModelAssetStatus::Loading:
+        return "loading";
+    case ModelAssetStatus::Ready:
+        return "ready";
+    case ModelAssetStatus::Failed:
+        return "failed";
+    default:
+        return "unloaded";
+    }
+}
+
+void shutdownModelRegistry() {
+    std::vector<ModelHandle> live = getLiveModels();
+    for (const ModelHandle& handle : live) {
+        handle->pending.reset();
+        if (handle->model) {
+            releaseModelBuffers(*handle->model);
+        }
+    }
+    registryState().shutDown = true;
+}
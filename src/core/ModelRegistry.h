@@ -0,0 +1,77 @@
+#ifndef MODEL_REGISTRY_H
+#define MODEL_REGISTRY_H
+
+#include "Model.h"
+#include "AsyncModel.h"
+#include <memory>
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+// 模型资源注册表：按规范化路径与导入选项去重，同一文件的多个使用者共享一份 GPU 数据。
+// 模型在线程池上异步加载，processModelLoads 在主线程完成上传；句柄在卸载 / 重新加载后保持有效。
+// 只在 GL 线程上使用
+enum class ModelAssetStatus {
+    Loading,
+    Ready,
+    Failed,
+    Unloaded
+};
+
+// 注册表中的一份模型；最后一个句柄释放时删除网格缓冲（纹理由纹理注册表的句柄释放）
+class ModelResource {
+public:
+    ModelResource(const std::string& key, const std::string& path, const std::string& sourcePath,
+        const ModelImportOptions& options);
+    ~ModelResource();
+    ModelResource(const ModelResource&) = delete;
+    ModelResource& operator=(const ModelResource&) = delete;
+
+    // 未就绪、加载失败或已卸载时为 nullptr；重新加载期间继续返回旧模型
+    Model* get() const { return model.get(); }
+
+    std::string key;        // 规范化路径 + 导入选项
+    std::string path;       // 规范化路径
+    std::string sourcePath; // 首次请求时的路径（经虚拟文件系统加载，资源包条目不能使用绝对路径）
+    ModelImportOptions options;
+    ModelAssetStatus status = ModelAssetStatus::Loading;
+    uint64_t generation = 0; // 每次加载完成加一，调用方据此发现模型被替换
+    std::unique_ptr<Model> model;
+    ModelLoadHandle pending; // 进行中的（重新）加载
+};
+
+using ModelHandle = std::shared_ptr<ModelResource>;
+
+// 返回共享句柄并在需要时开始异步加载（已卸载的条目重新加载）
+ModelHandle acquireModel(const std::string& path, const ModelImportOptions& options = ModelImportOptions());
+
+// 主线程每帧调用：完成 CPU 阶段已结束的加载的 GPU 上传并替换模型
+void processModelLoads();
+
+// 立即释放模型的网格缓冲与 CPU 数据，句柄保留（状态变为 Unloaded）
+void unloadModel(const ModelHandle& handle);
+// 重新从磁盘加载（命中 .meshcache 时直接映射）；加载完成前继续使用旧模型
+void reloadModel(const ModelHandle& handle);
+
+// 每份模型的内存统计
+struct ModelRecord {
+    std::string path;
+    long references = 0;
+    ModelAssetStatus status = ModelAssetStatus::Loading;
+    size_t meshes = 0;
+    size_t residentMeshes = 0;
+    size_t gpuBytes = 0;    // 网格顶点 / 索引缓冲（不含共享纹理，纹理见 getTextureRecords）
+    size_t cpuBytes = 0;    // 延迟上传保留的 CPU 端网格数据
+    size_t mappedBytes = 0; // 映射的 .meshcache
+    size_t textures = 0;
+};
+
+std::vector<ModelRecord> getModelRecords();
+std::vector<ModelHandle> getLiveModels();
+const char* getModelAssetStatusName(ModelAssetStatus status);
+
+// 退出前调用（需要 GL 上下文）：释放所有仍存活的模型，之后释放的句柄不再调用 GL
+void shutdownModelRegistry();
+
+#endif // MODEL_REGISTRY_H
@@ -0,0 +1,573 @@
+#include "ObjLoader.h"
+#include "VirtualFileSystem.h"
+#include "ThreadPool.h"
+#include <charconv>
+#include <thread>
+#include <unordered_map>
+#include <sstream>
+#include <iostream>
+#include <algorithm>
+#include <filesystem>
+#include <cfloat>
+#include <cstring>
+#include <cstdint>
+
+namespace {
+
+const size_t kMinChunkSize = 64 * 1024; // 小于此大小的块不值得单独开线程
+const unsigned int kNoMaterial = ~0u;
+
+enum CornerFlags : uint8_t {
+    kHasTexCoord = 1,
+    kHasNormal = 2,
+    kRelativePosition = 4, // 负数索引：记录为相对块起点的下标，第二遍加上块的基址
+    kRelativeTexCoord = 8,
+    kRelativeNormal = 16
+};
+
+struct ObjCorner {
+    int32_t position;
+    int32_t texCoord;
+    int32_t normal;
+    uint8_t flags;
+};
+
+struct ObjFace {
+    uint32_t firstCorner;
+    uint32_t cornerCount;
+    int32_t materialSlot; // 块内材质槽，-1 表示沿用上一块末尾的材质
+};
+
+struct ObjChunk {
+    const char* begin = nullptr;
+    const char* end = nullptr;
+
+    // 第一遍：块内解析结果
+    std::vector<glm::vec3> positions;
+    std::vector<glm::vec2> texCoords;
+    std::vector<glm::vec3> normals;
+    std::vector<ObjCorner> corners;
+    std::vector<ObjFace> faces;
+    std::vector<std::string> materialNames; // 块内 usemtl 名称（按首次出现）
+    std::vector<std::string> materialLibs;
+    int32_t lastSlot = -1;                  // 块末尾生效的材质槽
+    bool hasInheritedFaces = false;         // 存在第一个 usemtl 之前的面
+
+    // 块间前缀和与材质状态
+    size_t positionBase = 0;
+    size_t texCoordBase = 0;
+    size_t normalBase = 0;
+    unsigned int inheritedMaterial = kNoMaterial;
+    std::vector<unsigned int> slotMaterials;
+
+    // 第二遍：按材质分组的带索引网格
+    std::vector<MeshData> meshes;
+    std::vector<std::vector<unsigned int>> positionIds; // 每个顶点对应的全局位置下标（用于生成法线）
+    std::vector<uint8_t> missingNormals;
+    glm::vec3 boundsMin = glm::vec3(FLT_MAX);
+    glm::vec3 boundsMax = glm::vec3(-FLT_MAX);
+    size_t faceCount = 0;
+    size_t triangles = 0;
+    size_t invalidFaces = 0;
+};
+
+// 顶点去重键：材质 + 位置 / 纹理坐标 / 法线下标
+struct CornerKey {
+    uint32_t material;
+    int32_t position;
+    int32_t texCoord;
+    int32_t normal;
+
+    bool operator==(const CornerKey& other) const {
+        return material == other.material && position == other.position
+            && texCoord == other.texCoord && normal == other.normal;
+    }
+};
+
+struct CornerKeyHash {
+    size_t operator()(const CornerKey& key) const {
+        uint64_t h = (uint64_t)(uint32_t)key.position * 0x9E3779B97F4A7C15ull;
+        h ^= ((uint64_t)(uint32_t)key.texCoord + 0x632BE59BD9B4E019ull) * 0xC2B2AE3D27D4EB4Full;
+        h ^= ((uint64_t)(uint32_t)key.normal + 0x85EBCA77C2B2AE63ull) * 0x165667B19E3779F9ull;
+        h ^= (uint64_t)key.material << 47;
+        return (size_t)(h ^ (h >> 29));
+    }
+};
+
+inline const char* skipSpaces(const char* p, const char* end) {
+    while (p < end && (*p == ' ' || *p == '\t')) p++;
+    return p;
+}
+
+inline const char* skipLine(const char* p, const char* end) {
+    const char* newline = static_cast<const char*>(std::memchr(p, '\n', end - p));
+    return newline ? newline + 1 : end;
+}
+
+inline bool isSpace(char c) {
+    return c == ' ' || c == '\t';
+}
+
+inline bool matchKeyword(const char* p, const char* end, const char* keyword) {
+    size_t length = std::strlen(keyword);
+    return (size_t)(end - p) > length && std::memcmp(p, keyword, length) == 0 && isSpace(p[length]);
+}
+
+inline const char* parseFloat(const char* p, const char* end, float& value) {
+    p = skipSpaces(p, end);
+    if (p < end && *p == '+') p++;
+    std::from_chars_result result = std::from_chars(p, end, value);
+    if (result.ec != std::errc()) {
+        value = 0.0f;
+        return p;
+    }
+    return result.ptr;
+}
+
+inline bool parseInt(const char*& p, const char* end, int& value) {
+    bool negative = false;
+    if (p < end && (*p == '-' || *p == '+')) {
+        negative = (*p == '-');
+        p++;
+    }
+    if (p >= end || *p < '0' || *p > '9') return false;
+    int v = 0;
+    while (p < end && *p >= '0' && *p <= '9') {
+        v = v * 10 + (*p - '0');
+        p++;
+    }
+    value = negative ? -v : v;
+    return value != 0;
+}
+
+// 行尾剩余部分（去掉首尾空白）
+std::string parseRest(const char* p, const char* end) {
+    p = skipSpaces(p, end);
+    const char* e = p;
+    while (e < end && *e != '\n' && *e != '\r') e++;
+    while (e > p && isSpace(e[-1])) e--;
+    return std::string(p, e);
+}
+
+// OBJ 下标为 1 起；负数相对当前已定义的元素个数
+inline void encodeIndex(int value, size_t localCount, int32_t& out, uint8_t& flags, uint8_t relativeFlag) {
+    if (value > 0) {
+        out = value - 1;
+    } else {
+        out = (int32_t)localCount + value;
+        flags |= relativeFlag;
+    }
+}
+
+void parseFace(ObjChunk& chunk, const char* p, const char* end, int32_t slot) {
+    uint32_t first = (uint32_t)chunk.corners.size();
+    while (true) {
+        p = skipSpaces(p, end);
+        if (p >= end || *p == '\n' || *p == '\r' || *p == '#') break;
+
+        ObjCorner corner = { 0, 0, 0, 0 };
+        int value = 0;
+        bool valid = parseInt(p, end, value);
+        if (valid) {
+            encodeIndex(value, chunk.positions.size(), corner.position, corner.flags, kRelativePosition);
+            if (p < end && *p == '/') {
+                p++;
+                if (p < end && *p != '/') {
+                    valid = parseInt(p, end, value);
+                    encodeIndex(value, chunk.texCoords.size(), corner.texCoord, corner.flags, kRelativeTexCoord);
+                    corner.flags |= kHasTexCoord;
+                }
+                if (valid && p < end && *p == '/') {
+                    p++;
+                    valid = parseInt(p, end, value);
+                    encodeIndex(value, chunk.normals.size(), corner.normal, corner.flags, kRelativeNormal);
+                    corner.flags |= kHasNormal;
+                }
+            }
+        }
+        if (!valid || (p < end && !isSpace(*p) && *p != '\n' && *p != '\r')) {
+            chunk.corners.resize(first);
+            chunk.invalidFaces++;
+            return;
+        }
+        chunk.corners.push_back(corner);
+    }
+
+    uint32_t count = (uint32_t)chunk.corners.size() - first;
+    if (count < 3) {
+        chunk.corners.resize(first);
+        chunk.invalidFaces++;
+        return;
+    }
+    chunk.faces.push_back({ first, count, slot });
+    if (slot < 0) chunk.hasInheritedFaces = true;
+}
+
+void parseChunk(ObjChunk& chunk) {
+    const char* p = chunk.begin;
+    const char* end = chunk.end;
+    int32_t slot = -1;
+
+    while (p < end) {
+        const char* line = skipSpaces(p, end);
+        const char* next = skipLine(line, end);
+        p = next;
+        if (next - line < 2) continue;
+
+        switch (line[0]) {
+        case 'v': {
+            glm::vec3 v(0.0f);
+            if (isSpace(line[1])) {
+                const char* q = parseFloat(line + 2, next, v.x);
+                q = parseFloat(q, next, v.y);
+                parseFloat(q, next, v.z);
+                chunk.positions.push_back(v);
+            } else if (line[1] == 't' && next - line > 2 && isSpace(line[2])) {
+                const char* q = parseFloat(line + 3, next, v.x);
+                parseFloat(q, next, v.y);
+                chunk.texCoords.push_back(glm::vec2(v.x, v.y));
+            } else if (line[1] == 'n' && next - line > 2 && isSpace(line[2])) {
+                const char* q = parseFloat(line + 3, next, v.x);
+                q = parseFloat(q, next, v.y);
+                parseFloat(q, next, v.z);
+                chunk.normals.push_back(v);
+            }
+            break;
+        }
+        case 'f':
+            if (isSpace(line[1])) {
+                parseFace(chunk, line + 2, next, slot);
+            }
+            break;
+        case 'u':
+            if (matchKeyword(line, next, "usemtl")) {
+                std::string name = parseRest(line + 6, next);
+                auto it = std::find(chunk.materialNames.begin(), chunk.materialNames.end(), name);
+                slot = (int32_t)(it - chunk.materialNames.begin());
+                if (it == chunk.materialNames.end()) {
+                    chunk.materialNames.push_back(name);
+                }
+            }
+            break;
+        case 'm':
+            if (matchKeyword(line, next, "mtllib")) {
+                chunk.materialLibs.push_back(parseRest(line + 6, next));
+            }
+            break;
+        default:
+            break; // 注释、o / g / s 等对渲染无影响的语句
+        }
+    }
+    chunk.lastSlot = slot;
+}
+
+// 第二遍：解析下标、三角化、按材质分组并去重顶点
+void buildChunk(ObjChunk& chunk, const std::vector<glm::vec3>& positions,
+    const std::vector<glm::vec2>& texCoords, const std::vector<glm::vec3>& normals, size_t materialCount) {
+    chunk.meshes.resize(materialCount);
+    chunk.positionIds.resize(materialCount);
+    chunk.missingNormals.assign(materialCount, 0);
+
+    std::unordered_map<CornerKey, unsigned int, CornerKeyHash> cornerMap;
+    cornerMap.reserve(chunk.corners.size());
+    std::vector<unsigned int> faceVertices;
+
+    for (const ObjFace& face : chunk.faces) {
+        unsigned int material = face.materialSlot < 0 ? chunk.inheritedMaterial
+                                                      : chunk.slotMaterials[face.materialSlot];
+        MeshData& mesh = chunk.meshes[material];
+        std::vector<unsigned int>& ids = chunk.positionIds[material];
+
+        // 解析下标并校验范围
+        bool valid = true;
+        faceVertices.clear();
+        for (uint32_t i = 0; i < face.cornerCount && valid; i++) {
+            const ObjCorner& corner = chunk.corners[face.firstCorner + i];
+            int64_t v = corner.position + ((corner.flags & kRelativePosition) ? (int64_t)chunk.positionBase : 0);
+            int64_t t = -1;
+            int64_t n = -1;
+            if (corner.flags & kHasTexCoord) {
+                t = corner.texCoord + ((corner.flags & kRelativeTexCoord) ? (int64_t)chunk.texCoordBase : 0);
+            }
+            if (corner.flags & kHasNormal) {
+                n = corner.normal + ((corner.flags & kRelativeNormal) ? (int64_t)chunk.normalBase : 0);
+            }
+            if (v < 0 || v >= (int64_t)positions.size() || t >= (int64_t)texCoords.size()
+                || n >= (int64_t)normals.size() || ((corner.flags & kHasTexCoord) && t < 0)
+                || ((corner.flags & kHasNormal) && n < 0)) {
+                valid = false;
+                break;
+            }
+
+            CornerKey key = { material, (int32_t)v, (int32_t)t, (int32_t)n };
+            auto inserted = cornerMap.emplace(key, (unsigned int)mesh.vertices.size());
+            if (inserted.second) {
+                Vertex vertex;
+                vertex.Position = positions[v];
+                vertex.Normal = n >= 0 ? normals[n] : glm::vec3(0.0f, 1.0f, 0.0f);
+                vertex.TexCoords = t >= 0 ? glm::vec2(texCoords[t].x, 1.0f - texCoords[t].y) : glm::vec2(0.0f);
+                if (n < 0) chunk.missingNormals[material] = 1;
+                mesh.vertices.push_back(vertex);
+                ids.push_back((unsigned int)v);
+                chunk.boundsMin = glm::min(chunk.boundsMin, vertex.Position);
+                chunk.boundsMax = glm::max(chunk.boundsMax, vertex.Position);
+            }
+            faceVertices.push_back(inserted.first->second);
+        }
+        if (!valid) {
+            chunk.invalidFaces++;
+            continue;
+        }
+
+        // 扇形三角化
+        for (size_t i = 1; i + 1 < faceVertices.size(); i++) {
+            mesh.indices.push_back(faceVertices[0]);
+            mesh.indices.push_back(faceVertices[i]);
+            mesh.indices.push_back(faceVertices[i + 1]);
+            chunk.triangles++;
+        }
+    }
+
+    // 第一遍数据已不再需要
+    chunk.faceCount = chunk.faces.size();
+    std::vector<ObjCorner>().swap(chunk.corners);
+    std::vector<ObjFace>().swap(chunk.faces);
+}
+
+// 按共享位置累加面积加权的面法线
+void generateSmoothNormals(MeshData& mesh, const std::vector<unsigned int>& positionIds, size_t positionCount) {
+    std::vector<glm::vec3> accumulated(positionCount, glm::vec3(0.0f));
+    for (size_t i = 0; i + 2 < mesh.indices.size(); i += 3) {
+        unsigned int a = mesh.indices[i], b = mesh.indices[i + 1], c = mesh.indices[i + 2];
+        glm::vec3 faceNormal = glm::cross(mesh.vertices[b].Position - mesh.vertices[a].Position,
+                                          mesh.vertices[c].Position - mesh.vertices[a].Position);
+        accumulated[positionIds[a]] += faceNormal;
+        accumulated[positionIds[b]] += faceNormal;
+        accumulated[positionIds[c]] += faceNormal;
+    }
+    for (size_t i = 0; i < mesh.vertices.size(); i++) {
+        glm::vec3 n = accumulated[positionIds[i]];
+        float length = glm::length(n);
+        mesh.vertices[i].Normal = length > 0.0f ? n / length : glm::vec3(0.0f, 1.0f, 0.0f);
+    }
+}
+
+void parseMtl(const std::string& path, std::vector<ModelMaterial>& materials) {
+    std::string text;
+    if (!readVirtualTextFile(path, text)) return;
+    std::istringstream file(text);
+
+    std::string line;
+    bool hasMaterial = false;
+    while (std::getline(file, line)) {
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        std::istringstream ss(line);
+        std::string key;
+        if (!(ss >> key) || key[0] == '#') continue;
+
+        std::string rest;
+        std::getline(ss >> std::ws, rest);
+
+        if (key == "newmtl") {
+            ModelMaterial material;
+            material.name = rest;
+            materials.push_back(material);
+            hasMaterial = true;
+        } else if (!hasMaterial) {
+            continue;
+        } else if (key == "map_Kd") {
+            // 带选项（-s / -o 等）时文件名为最后一项
+            if (!rest.empty() && rest[0] == '-') {
+                size_t lastSpace = rest.find_last_of(" \t");
+                if (lastSpace != std::string::npos) rest = rest.substr(lastSpace + 1);
+            }
+            materials.back().diffusePath = rest;
+        } else if (key == "map_d") {
+            materials.back().opaque = false;
+        } else if (key == "d") {
+            float d = 1.0f;
+            if (std::istringstream(rest) >> d && d < 1.0f) materials.back().opaque = false;
+        } else if (key == "Tr") {
+            float tr = 0.0f;
+            if (std::istringstream(rest) >> tr && tr > 0.0f) materials.back().opaque = false;
+        }
+    }
+}
+
+} // namespace
+
+bool loadObj(const std::string& path, ObjScene& scene, unsigned int threadCount, bool quiet) {
+    VirtualFile file;
+    if (!file.open(path)) {
+        std::cerr << "[ObjLoader] Cannot open file: " << path << std::endl;
+        return false;
+    }
+
+    if (threadCount == 0) {
+        threadCount = std::max(1u, std::thread::hardware_concurrency());
+    }
+    const char* data = reinterpret_cast<const char*>(file.data());
+    size_t size = file.size();
+    size_t chunkCount = std::max<size_t>(1, std::min<size_t>(threadCount, size / kMinChunkSize));
+
+    // 按行边界切块
+    std::vector<ObjChunk> chunks(chunkCount);
+    const char* cursor = data;
+    for (size_t i = 0; i < chunkCount; i++) {
+        chunks[i].begin = cursor;
+        if (i + 1 == chunkCount) {
+            cursor = data + size;
+        } else {
+            const char* target = std::max(cursor, data + size * (i + 1) / chunkCount);
+            cursor = skipLine(target, data + size);
+        }
+        chunks[i].end = cursor;
+    }
+
+    // 第一遍：并行解析
+    getThreadPool().parallelFor(chunkCount, [&](size_t i) { parseChunk(chunks[i]); });
+
+    // 前缀和（相对索引的基址）与跨块的材质状态
+    std::vector<ModelMaterial> materials;
+    std::vector<std::string> loadedLibs;
+    size_t slash = path.find_last_of("/\\");
+    std::string directory = (slash == std::string::npos) ? "." : path.substr(0, slash);
+    for (const ObjChunk& chunk : chunks) {
+        for (const std::string& lib : chunk.materialLibs) {
+            if (std::find(loadedLibs.begin(), loadedLibs.end(), lib) != loadedLibs.end()) continue;
+            loadedLibs.push_back(lib);
+
+            std::string libPath = directory + "/" + lib;
+            if (!virtualFileExists(libPath)) {
+                // Mineways 导出的 mtllib 名称与实际文件名不一致时，退回同名 .mtl
+                std::string fallback = directory + "/" + std::filesystem::path(path).stem().string() + ".mtl";
+                if (!virtualFileExists(fallback)) {
+                    scene.stats.missingMaterialLibraries.push_back(libPath);
+                    if (!quiet) {
+                        std::cerr << "[ObjLoader] Material library not found: " << libPath << std::endl;
+                    }
+                    continue;
+                }
+                libPath = fallback;
+            }
+            parseMtl(libPath, materials);
+        }
+    }
+
+    auto findMaterial = [&](const std::string& name) {
+        for (size_t i = 0; i < materials.size(); i++) {
+            if (materials[i].name == name) return (unsigned int)i;
+        }
+        ModelMaterial material;
+        material.name = name;
+        materials.push_back(material);
+        return (unsigned int)(materials.size() - 1);
+    };
+
+    size_t positionCount = 0, texCoordCount = 0, normalCount = 0;
+    unsigned int currentMaterial = kNoMaterial;
+    for (ObjChunk& chunk : chunks) {
+        chunk.positionBase = positionCount;
+        chunk.texCoordBase = texCoordCount;
+        chunk.normalBase = normalCount;
+        positionCount += chunk.positions.size();
+        texCoordCount += chunk.texCoords.size();
+        normalCount += chunk.normals.size();
+
+        if (chunk.hasInheritedFaces && currentMaterial == kNoMaterial) {
+            currentMaterial = findMaterial("default");
+        }
+        chunk.inheritedMaterial = currentMaterial;
+        for (const std::string& name : chunk.materialNames) {
+            chunk.slotMaterials.push_back(findMaterial(name));
+        }
+        if (chunk.lastSlot >= 0) {
+            currentMaterial = chunk.slotMaterials[chunk.lastSlot];
+        }
+    }
+
+    // 拼接全局属性数组
+    std::vector<glm::vec3> positions;
+    std::vector<glm::vec2> texCoords;
+    std::vector<glm::vec3> normals;
+    positions.reserve(positionCount);
+    texCoords.reserve(texCoordCount);
+    normals.reserve(normalCount);
+    for (ObjChunk& chunk : chunks) {
+        positions.insert(positions.end(), chunk.positions.begin(), chunk.positions.end());
+        texCoords.insert(texCoords.end(), chunk.texCoords.begin(), chunk.texCoords.end());
+        normals.insert(normals.end(), chunk.normals.begin(), chunk.normals.end());
+        std::vector<glm::vec3>().swap(chunk.positions);
+        std::vector<glm::vec2>().swap(chunk.texCoords);
+        std::vector<glm::vec3>().swap(chunk.normals);
+    }
+
+    // 第二遍：并行三角化与顶点去重
+    getThreadPool().parallelFor(chunkCount, [&](size_t i) {
+        buildChunk(chunks[i], positions, texCoords, normals, materials.size());
+    });
+
+    // 按块顺序合并各材质的网格（块边界处的重复顶点由导入后的焊接处理）
+    scene = ObjScene();
+    scene.boundsMin = glm::vec3(FLT_MAX);
+    scene.boundsMax = glm::vec3(-FLT_MAX);
+    size_t invalidFaces = 0;
+    for (const ObjChunk& chunk : chunks) {
+        scene.boundsMin = glm::min(scene.boundsMin, chunk.boundsMin);
+        scene.boundsMax = glm::max(scene.boundsMax, chunk.boundsMax);
+        scene.stats.triangles += chunk.triangles;
+        invalidFaces += chunk.invalidFaces;
+    }
+
+    for (unsigned int m = 0; m < materials.size(); m++) {
+        MeshData mesh;
+        mesh.materialIndex = m;
+        std::vector<unsigned int> ids;
+        bool missingNormals = false;
+        size_t vertexTotal = 0, indexTotal = 0;
+        for (const ObjChunk& chunk : chunks) {
+            vertexTotal += chunk.meshes[m].vertices.size();
+            indexTotal += chunk.meshes[m].indices.size();
+        }
+        if (indexTotal == 0) continue;
+
+        mesh.vertices.reserve(vertexTotal);
+        mesh.indices.reserve(indexTotal);
+        ids.reserve(vertexTotal);
+        for (ObjChunk& chunk : chunks) {
+            MeshData& part = chunk.meshes[m];
+            unsigned int base = (unsigned int)mesh.vertices.size();
+            mesh.vertices.insert(mesh.vertices.end(), part.vertices.begin(), part.vertices.end());
+            for (unsigned int index : part.indices) {
+                mesh.indices.push_back(base + index);
+            }
+            ids.insert(ids.end(), chunk.positionIds[m].begin(), chunk.positionIds[m].end());
+            missingNormals = missingNormals || chunk.missingNormals[m];
+            std::vector<Vertex>().swap(part.vertices);
+        }
+
+        if (missingNormals) {
+            generateSmoothNormals(mesh, ids, positions.size());
+        }
+        scene.meshes.push_back(std::move(mesh));
+    }
+
+    if (scene.meshes.empty()) {
+        std::cerr << "[ObjLoader] No faces found in: " << path << std::endl;
+        return false;
+    }
+    scene.stats.invalidFaces = invalidFaces;
+    if (invalidFaces > 0 && !quiet) {
+        std::cerr << "[ObjLoader] Skipped " << invalidFaces << " invalid faces in: " << path << std::endl;
+    }
+
+    scene.materials = std::move(materials);
+    scene.stats.positions = positionCount;
+    scene.stats.texCoords = texCoordCount;
+    scene.stats.normals = normalCount;
+    for (const ObjChunk& chunk : chunks) {
+        scene.stats.faces += chunk.faceCount;
+    }
+    scene.stats.threads = (unsigned int)chunkCount;
+    return true;
+}
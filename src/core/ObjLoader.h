@@ -0,0 +1,36 @@
+#ifndef OBJ_LOADER_H
+#define OBJ_LOADER_H
+
+#include "../geometry/Mesh.h"
+#include <glm/glm.hpp>
+#include <string>
+#include <vector>
+
+struct ObjLoadStats {
+    size_t positions = 0;
+    size_t texCoords = 0;
+    size_t normals = 0;
+    size_t faces = 0;
+    size_t triangles = 0;
+    unsigned int threads = 0;
+    size_t invalidFaces = 0;
+    std::vector<std::string> missingMaterialLibraries;
+};
+
+// OBJ 解析结果：每个材质一个带索引的 MeshData（原始坐标，未缩放），
+// V 坐标已翻转（与 aiProcess_FlipUVs 一致），缺少法线时生成平滑法线
+struct ObjScene {
+    std::vector<MeshData> meshes;
+    std::vector<ModelMaterial> materials;
+    glm::vec3 boundsMin = glm::vec3(0.0f); // 被面引用的顶点的包围盒
+    glm::vec3 boundsMax = glm::vec3(0.0f);
+    ObjLoadStats stats;
+};
+
+// 内置 OBJ/MTL 加载器：经虚拟文件系统映射文件，按行边界分块后在共享线程池上并行解析，
+// 支持负数（相对）索引、多边形扇形三角化、跨块的 usemtl 状态与多材质
+// threadCount 为分块数上限，为 0 时使用硬件线程数；quiet 为 true 时不输出缺失材质库 / 无效面的警告
+// （仍记录在 stats 中，基准测试的计时循环使用）
+bool loadObj(const std::string& path, ObjScene& scene, unsigned int threadCount = 0, bool quiet = false);
+
+#endif // OBJ_LOADER_H
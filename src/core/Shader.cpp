@@ -1,17 +1,18 @@
 #include "Shader.h"
+#include "VirtualFileSystem.h"
+#include "AssetManifest.h"
 #include <iostream>
-#include <fstream>
-#include <sstream>
+#include <string>
 
+// 着色器源码经虚拟文件系统读取（资源包优先，其次为散文件）；
+// 烘焙清单中有预处理版本时读取预处理版本
 static std::string readFile(const char* path) {
-    std::ifstream in(path);
-    if (!in) {
+    std::string source;
+    if (!readVirtualTextFile(getCookedAssetPath(path), source)) {
         std::cerr << "Failed to open: " << path << std::endl;
         return "";
     }
-    std::stringstream ss;
-    ss << in.rdbuf();
-    return ss.str();
+    return source;
 }
 
 Shader::Shader() : ID(0) {}
@@ -66,6 +67,10 @@ void Shader::setVec3(const char* name, const glm::vec3& v) const {
     glUniform3fv(glGetUniformLocation(ID, name), 1, glm::value_ptr(v));
 }
 
+void Shader::setVec4(const char* name, const glm::vec4& v) const {
+    glUniform4fv(glGetUniformLocation(ID, name), 1, glm::value_ptr(v));
+}
+
 void Shader::setFloat(const char* name, float f) const {
     glUniform1f(glGetUniformLocation(ID, name), f);
 }
@@ -14,6 +14,7 @@ public:
     void setMat4(const char* name, const glm::mat4& m) const;
     void setVec3(const char* name, float x, float y, float z) const;
     void setVec3(const char* name, const glm::vec3& v) const;
+    void setVec4(const char* name, const glm::vec4& v) const;
     void setFloat(const char* name, float f) const;
     void setInt(const char* name, int v) const;
     void setBool(const char* name, bool v) const;
@@ -1,7 +1,41 @@
 #define STB_IMAGE_IMPLEMENTATION
 #include "Texture.h"
+#include "MipGenerator.h"
+#include "ImageDecoder.h"
 #include "../../include/stb/stb_image.h"
 #include <iostream>
+#include <algorithm>
+
+namespace {
+TextureQuality textureQuality = TextureQuality::Full;
+}
+
+void setTextureQuality(TextureQuality quality) {
+    textureQuality = quality;
+}
+
+TextureQuality getTextureQuality() {
+    return textureQuality;
+}
+
+const char* getTextureQualityName(TextureQuality quality) {
+    switch (quality) {
+    case TextureQuality::Half: return "half";
+    case TextureQuality::Quarter: return "quarter";
+    default: return "full";
+    }
+}
+
+bool parseTextureQuality(const std::string& name, TextureQuality& quality) {
+    const TextureQuality qualities[] = { TextureQuality::Full, TextureQuality::Half, TextureQuality::Quarter };
+    for (TextureQuality candidate : qualities) {
+        if (name == getTextureQualityName(candidate)) {
+            quality = candidate;
+            return true;
+        }
+    }
+    return false;
+}
 
 unsigned int loadTexture(const char* path) {
     unsigned int textureID;
@@ -9,7 +43,7 @@ unsigned int loadTexture(const char* path) {
 
     int width, height, nrComponents;
     stbi_set_flip_vertically_on_load(false);
-    unsigned char* data = stbi_load(path, &width, &height, &nrComponents, 0);
+    unsigned char* data = loadImage(path, &width, &height, &nrComponents, 0, (int)getTextureQuality());
     if (data) {
         GLenum format;
         if (nrComponents == 1)
@@ -19,21 +53,31 @@ unsigned int loadTexture(const char* path) {
         else if (nrComponents == 4)
             format = GL_RGBA;
 
+        // CPU 生成 gamma 校正的 mip 链，逐级上传
+        std::vector<std::vector<unsigned char>> mips;
+        generateMipChain(data, width, height, nrComponents, true, mips);
+
         glBindTexture(GL_TEXTURE_2D, textureID);
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
         glTexImage2D(GL_TEXTURE_2D, 0, format, width, height, 0, format, GL_UNSIGNED_BYTE, data);
-        glGenerateMipmap(GL_TEXTURE_2D);
+        for (size_t level = 0; level < mips.size(); level++) {
+            int levelWidth = std::max(1, width >> (level + 1));
+            int levelHeight = std::max(1, height >> (level + 1));
+            glTexImage2D(GL_TEXTURE_2D, (GLint)level + 1, format, levelWidth, levelHeight, 0, format, GL_UNSIGNED_BYTE, mips[level].data());
+        }
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
 
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
 
-        stbi_image_free(data);
+        freeImage(data);
         std::cout << "Texture loaded successfully: " << path << std::endl;
     }
     else {
         std::cerr << "Texture failed to load at path: " << path << std::endl;
-        stbi_image_free(data);
+        freeImage(data);
     }
 
     return textureID;
@@ -48,12 +92,12 @@ unsigned int loadCubemap(const std::vector<std::string>& faces) {
     stbi_set_flip_vertically_on_load(false);
 
     for (unsigned int i = 0; i < faces.size(); i++) {
-        unsigned char* data = stbi_load(faces[i].c_str(), &width, &height, &nrChannels, 0);
+        unsigned char* data = loadImage(faces[i].c_str(), &width, &height, &nrChannels, 0);
         if (data) {
             GLenum format = (nrChannels == 3) ? GL_RGB : GL_RGBA;
             glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i,
                 0, format, width, height, 0, format, GL_UNSIGNED_BYTE, data);
-            stbi_image_free(data);
+            freeImage(data);
         }
         else {
             std::cerr << "Cubemap texture failed to load at path: " << faces[i] << std::endl;
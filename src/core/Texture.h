@@ -5,6 +5,20 @@
 #include <vector>
 #include <string>
 
+// 纹理质量档位：加载时按档位缩小 2D 纹理（half = 边长 1/2，quarter = 1/4），
+// 源图像在解码阶段缩小，烘焙的压缩纹理跳过顶层 mip。立方体贴图不受影响
+enum class TextureQuality {
+    Full = 0,
+    Half = 1,
+    Quarter = 2
+};
+
+void setTextureQuality(TextureQuality quality);
+TextureQuality getTextureQuality();
+const char* getTextureQualityName(TextureQuality quality);
+// 解析 "full" / "half" / "quarter"，无法识别时返回 false
+bool parseTextureQuality(const std::string& name, TextureQuality& quality);
+
 unsigned int loadTexture(const char* path);
 unsigned int loadCubemap(const std::vector<std::string>& faces);
 
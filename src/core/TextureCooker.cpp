@@ -0,0 +1,312 @@
+#include "TextureCooker.h"
+#include "MeshCache.h"
+#include "ThreadPool.h"
+#include "MipGenerator.h"
+#include "ImageDecoder.h"
+#include "VirtualFileSystem.h"
+#include <iostream>
+#include <fstream>
+#include <filesystem>
+#include <algorithm>
+#include <cstring>
+#include <thread>
+#define STB_DXT_IMPLEMENTATION
+#include "../../include/stb/stb_dxt.h"
+
+namespace fs = std::filesystem;
+
+// 系统 glad 未包含 S3TC 扩展枚举
+#ifndef GL_COMPRESSED_RGBA_S3TC_DXT1_EXT
+#define GL_COMPRESSED_RGBA_S3TC_DXT1_EXT 0x83F1
+#endif
+#ifndef GL_COMPRESSED_RGBA_S3TC_DXT5_EXT
+#define GL_COMPRESSED_RGBA_S3TC_DXT5_EXT 0x83F3
+#endif
+
+namespace {
+
+// DDS 文件头（Microsoft DDS_HEADER / DDS_PIXELFORMAT）
+struct DdsPixelFormat {
+    uint32_t size;
+    uint32_t flags;
+    uint32_t fourCC;
+    uint32_t rgbBitCount;
+    uint32_t rMask, gMask, bMask, aMask;
+};
+
+struct DdsHeader {
+    uint32_t size;
+    uint32_t flags;
+    uint32_t height;
+    uint32_t width;
+    uint32_t pitchOrLinearSize;
+    uint32_t depth;
+    uint32_t mipMapCount;
+    uint32_t reserved1[11]; // [0] 标记 [1] 版本 [2..3] 源大小 [4..5] 源修改时间 [6..7] 源哈希
+    DdsPixelFormat pixelFormat;
+    uint32_t caps;
+    uint32_t caps2;
+    uint32_t caps3;
+    uint32_t caps4;
+    uint32_t reserved2;
+};
+static_assert(sizeof(DdsHeader) == 124, "DDS header must be 124 bytes");
+
+constexpr uint32_t makeFourCC(char a, char b, char c, char d) {
+    return (uint32_t)(uint8_t)a | ((uint32_t)(uint8_t)b << 8) | ((uint32_t)(uint8_t)c << 16) | ((uint32_t)(uint8_t)d << 24);
+}
+
+const uint32_t kDdsMagic = makeFourCC('D', 'D', 'S', ' ');
+const uint32_t kCookTag = makeFourCC('S', 'F', 'T', 'C');
+const uint32_t kCookVersion = 2; // 2：gamma 校正的 mip 链
+
+const uint32_t DDSD_CAPS = 0x1, DDSD_HEIGHT = 0x2, DDSD_WIDTH = 0x4, DDSD_PIXELFORMAT = 0x1000;
+const uint32_t DDSD_MIPMAPCOUNT = 0x20000, DDSD_LINEARSIZE = 0x80000;
+const uint32_t DDPF_FOURCC = 0x4;
+const uint32_t DDSCAPS_COMPLEX = 0x8, DDSCAPS_TEXTURE = 0x1000, DDSCAPS_MIPMAP = 0x400000;
+
+void writeU64(uint32_t* dst, uint64_t value) {
+    dst[0] = (uint32_t)(value & 0xFFFFFFFFu);
+    dst[1] = (uint32_t)(value >> 32);
+}
+
+uint64_t readU64(const uint32_t* src) {
+    return (uint64_t)src[0] | ((uint64_t)src[1] << 32);
+}
+
+// 编码单个 mip 级别：每个块行是一个并行任务，边缘不足 4 像素的块按钳制坐标补齐。
+// 块编码使用标量的 stb_dxt（没有可用的 SIMD BC 编码器），并行度来自块行；
+// 完整块的每行 4 个像素是连续的 16 字节，整行复制（编译为一次 16 字节向量读写）
+void compressLevel(const unsigned char* rgba, int width, int height, BlockFormat format, std::vector<uint8_t>& out) {
+    int blocksX = (width + 3) / 4;
+    int blocksY = (height + 3) / 4;
+    size_t blockBytes = (format == BlockFormat::BC1) ? 8 : 16;
+    int alpha = (format == BlockFormat::BC3) ? 1 : 0;
+    out.resize((size_t)blocksX * blocksY * blockBytes);
+
+    getThreadPool().parallelFor((size_t)blocksY, [&](size_t by) {
+        unsigned char block[16 * 4];
+        bool fullRows = (int)by * 4 + 4 <= height;
+        for (int bx = 0; bx < blocksX; bx++) {
+            if (fullRows && bx * 4 + 4 <= width) {
+                for (int py = 0; py < 4; py++) {
+                    std::memcpy(&block[py * 16], &rgba[(((size_t)by * 4 + py) * width + (size_t)bx * 4) * 4], 16);
+                }
+                stb_compress_dxt_block(&out[(by * blocksX + bx) * blockBytes], block, alpha, STB_DXT_HIGHQUAL);
+                continue;
+            }
+            for (int py = 0; py < 4; py++) {
+                int y = std::min((int)by * 4 + py, height - 1);
+                for (int px = 0; px < 4; px++) {
+                    int x = std::min(bx * 4 + px, width - 1);
+                    std::memcpy(&block[(py * 4 + px) * 4], &rgba[((size_t)y * width + x) * 4], 4);
+                }
+            }
+            stb_compress_dxt_block(&out[(by * blocksX + bx) * blockBytes], block, alpha, STB_DXT_HIGHQUAL);
+        }
+    });
+}
+
+} // namespace
+
+bool isS3TCSupported() {
+    static int supported = -1;
+    if (supported < 0) {
+        supported = 0;
+        GLint count = 0;
+        glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+        for (GLint i = 0; i < count; i++) {
+            const char* name = (const char*)glGetStringi(GL_EXTENSIONS, (GLuint)i);
+            if (name && std::strcmp(name, "GL_EXT_texture_compression_s3tc") == 0) {
+                supported = 1;
+                break;
+            }
+        }
+        std::cout << "[TextureCooker] S3TC " << (supported ? "supported" : "not supported, textures stay uncompressed") << std::endl;
+    }
+    return supported == 1;
+}
+
+GLenum compressedInternalFormat(BlockFormat format) {
+    return (format == BlockFormat::BC1) ? GL_COMPRESSED_RGBA_S3TC_DXT1_EXT : GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+}
+
+size_t compressedLevelSize(BlockFormat format, int width, int height) {
+    size_t blockBytes = (format == BlockFormat::BC1) ? 8 : 16;
+    return (size_t)((width + 3) / 4) * ((height + 3) / 4) * blockBytes;
+}
+
+void compressImage(const unsigned char* rgba, int width, int height, bool mipmaps, CompressedImage& out) {
+    size_t pixelCount = (size_t)width * height;
+
+    // 存在半透明像素时使用 BC3，否则 BC1（体积减半）
+    out.format = BlockFormat::BC1;
+    for (size_t i = 0; i < pixelCount; i++) {
+        if (rgba[i * 4 + 3] != 255) {
+            out.format = BlockFormat::BC3;
+            break;
+        }
+    }
+    out.width = width;
+    out.height = height;
+
+    int levels = mipmaps ? getMipLevelCount(width, height) : 1;
+    out.levels.assign(levels, std::vector<uint8_t>());
+
+    // 下一级 mip 由上一级未压缩图像生成（gamma 校正），再分别编码
+    std::vector<unsigned char> current, next;
+    int w = width, h = height;
+    for (int level = 0; level < levels; level++) {
+        const unsigned char* src = (level == 0) ? rgba : current.data();
+        compressLevel(src, w, h, out.format, out.levels[level]);
+        if (level + 1 < levels) {
+            downsampleImage(src, w, h, 4, true, next);
+            current.swap(next);
+            w = std::max(1, w / 2);
+            h = std::max(1, h / 2);
+        }
+    }
+}
+
+std::string getCookedTexturePath(const std::string& sourcePath) {
+    return sourcePath + ".dds";
+}
+
+bool readCookedTexture(const std::string& sourcePath, bool mipmaps, CompressedImage& out) {
+    std::string cookedPath = getCookedTexturePath(sourcePath);
+    VirtualFile file;
+    if (!file.open(cookedPath)) return false;
+
+    uint32_t magic = 0;
+    DdsHeader header;
+    size_t offset = sizeof(magic) + sizeof(header);
+    if (file.size() < offset) {
+        std::cerr << "[TextureCooker] Invalid cooked texture: " << cookedPath << std::endl;
+        return false;
+    }
+    std::memcpy(&magic, file.data(), sizeof(magic));
+    std::memcpy(&header, file.data() + sizeof(magic), sizeof(header));
+    if (magic != kDdsMagic || header.size != sizeof(DdsHeader)) {
+        std::cerr << "[TextureCooker] Invalid cooked texture: " << cookedPath << std::endl;
+        return false;
+    }
+    if (header.reserved1[0] != kCookTag || header.reserved1[1] != kCookVersion) {
+        return false;
+    }
+
+    BlockFormat format;
+    if (header.pixelFormat.fourCC == makeFourCC('D', 'X', 'T', '1')) format = BlockFormat::BC1;
+    else if (header.pixelFormat.fourCC == makeFourCC('D', 'X', 'T', '5')) format = BlockFormat::BC3;
+    else return false;
+
+    int width = (int)header.width;
+    int height = (int)header.height;
+    int levels = std::max(1, (int)header.mipMapCount);
+    if (width <= 0 || height <= 0 || levels != (mipmaps ? getMipLevelCount(width, height) : 1)) {
+        return false;
+    }
+
+    // 源文件校验规则与网格缓存一致：大小 + 修改时间，必要时比较内容哈希
+    MeshCacheSource source;
+    if (queryMeshCacheSource(sourcePath, source, false)) {
+        bool stale = source.size != readU64(&header.reserved1[2]);
+        if (!stale && source.mtime != (int64_t)readU64(&header.reserved1[4])) {
+            stale = !queryMeshCacheSource(sourcePath, source, true) || source.hash != readU64(&header.reserved1[6]);
+        }
+        if (stale) {
+            std::cout << "[TextureCooker] Source changed, recooking: " << sourcePath << std::endl;
+            return false;
+        }
+    }
+
+    out.format = format;
+    out.width = width;
+    out.height = height;
+    out.levels.assign(levels, std::vector<uint8_t>());
+    int w = width, h = height;
+    for (int level = 0; level < levels; level++) {
+        size_t levelSize = compressedLevelSize(format, w, h);
+        if (levelSize > file.size() - offset) {
+            std::cerr << "[TextureCooker] Truncated cooked texture: " << cookedPath << std::endl;
+            return false;
+        }
+        out.levels[level].assign(file.data() + offset, file.data() + offset + levelSize);
+        offset += levelSize;
+        w = std::max(1, w / 2);
+        h = std::max(1, h / 2);
+    }
+    return true;
+}
+
+bool writeCookedTexture(const std::string& sourcePath, const CompressedImage& image) {
+    MeshCacheSource source;
+    if (!queryMeshCacheSource(sourcePath, source, true)) return false;
+
+    DdsHeader header = {};
+    header.size = sizeof(DdsHeader);
+    header.flags = DDSD_CAPS | DDSD_HEIGHT | DDSD_WIDTH | DDSD_PIXELFORMAT | DDSD_LINEARSIZE;
+    header.height = (uint32_t)image.height;
+    header.width = (uint32_t)image.width;
+    header.pitchOrLinearSize = (uint32_t)image.levels[0].size();
+    header.mipMapCount = (uint32_t)image.levels.size();
+    header.reserved1[0] = kCookTag;
+    header.reserved1[1] = kCookVersion;
+    writeU64(&header.reserved1[2], source.size);
+    writeU64(&header.reserved1[4], (uint64_t)source.mtime);
+    writeU64(&header.reserved1[6], source.hash);
+    header.pixelFormat.size = sizeof(DdsPixelFormat);
+    header.pixelFormat.flags = DDPF_FOURCC;
+    header.pixelFormat.fourCC = (image.format == BlockFormat::BC1)
+        ? makeFourCC('D', 'X', 'T', '1') : makeFourCC('D', 'X', 'T', '5');
+    header.caps = DDSCAPS_TEXTURE;
+    if (image.levels.size() > 1) {
+        header.flags |= DDSD_MIPMAPCOUNT;
+        header.caps |= DDSCAPS_COMPLEX | DDSCAPS_MIPMAP;
+    }
+
+    // 先写临时文件再替换，多个线程同时烘焙同一图像时也不会读到半个文件
+    std::string cookedPath = getCookedTexturePath(sourcePath);
+    std::string tempPath = cookedPath + ".tmp" + std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id()));
+    {
+        std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+        if (!file) {
+            std::cerr << "[TextureCooker] Cannot write cooked texture: " << cookedPath << std::endl;
+            return false;
+        }
+        file.write((const char*)&kDdsMagic, sizeof(kDdsMagic));
+        file.write((const char*)&header, sizeof(header));
+        for (const std::vector<uint8_t>& level : image.levels) {
+            file.write((const char*)level.data(), (std::streamsize)level.size());
+        }
+        if (!file) {
+            file.close();
+            fs::remove(tempPath);
+            return false;
+        }
+    }
+
+    std::error_code ec;
+    fs::rename(tempPath, cookedPath, ec);
+    if (ec) {
+        fs::remove(tempPath, ec);
+        return false;
+    }
+    return true;
+}
+
+bool cookTexture(const std::string& sourcePath, bool mipmaps, CompressedImage& out) {
+    if (readCookedTexture(sourcePath, mipmaps, out)) return true;
+
+    int width, height, channels;
+    unsigned char* pixels = loadImage(sourcePath.c_str(), &width, &height, &channels, 4);
+    if (!pixels) return false;
+
+    compressImage(pixels, width, height, mipmaps, out);
+    freeImage(pixels);
+
+    if (writeCookedTexture(sourcePath, out)) {
+        std::cout << "[TextureCooker] Cooked " << (out.format == BlockFormat::BC1 ? "BC1" : "BC3") << " "
+            << width << "x" << height << " (" << out.levels.size() << " mips): " << sourcePath << std::endl;
+    }
+    return true;
+}
@@ -0,0 +1,39 @@
+#ifndef TEXTURE_COOKER_H
+#define TEXTURE_COOKER_H
+
+#include <glad/glad.h>
+#include <string>
+#include <vector>
+#include <cstdint>
+
+// 块压缩格式（DDS FourCC：DXT1 / DXT5）
+enum class BlockFormat : uint32_t {
+    BC1 = 1, // RGB，8 字节 / 4x4 块
+    BC3 = 3  // RGBA，16 字节 / 4x4 块
+};
+
+struct CompressedImage {
+    BlockFormat format = BlockFormat::BC1;
+    int width = 0;
+    int height = 0;
+    std::vector<std::vector<uint8_t>> levels; // levels[0] 为全尺寸
+};
+
+// 当前上下文是否支持 GL_EXT_texture_compression_s3tc（需在主线程调用）
+bool isS3TCSupported();
+GLenum compressedInternalFormat(BlockFormat format);
+size_t compressedLevelSize(BlockFormat format, int width, int height);
+
+// 把 RGBA8 图像编码为块压缩格式；mipmaps 为 true 时生成完整 mip 链
+// 在工作线程中调用，块行在共享线程池上并行编码
+void compressImage(const unsigned char* rgba, int width, int height, bool mipmaps, CompressedImage& out);
+
+// 烘焙缓存：<源图像路径>.dds，文件头保留字段记录源文件大小 / 修改时间 / 哈希
+std::string getCookedTexturePath(const std::string& sourcePath);
+bool readCookedTexture(const std::string& sourcePath, bool mipmaps, CompressedImage& out);
+bool writeCookedTexture(const std::string& sourcePath, const CompressedImage& image);
+
+// 优先读取有效缓存；否则解码源图像、编码并写回缓存。源图像无法解码时返回 false
+bool cookTexture(const std::string& sourcePath, bool mipmaps, CompressedImage& out);
+
+#endif // TEXTURE_COOKER_H
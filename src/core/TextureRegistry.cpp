@@ -0,0 +1,249 @@
+#include "TextureRegistry.h"
+#include "AsyncTexture.h"
+#include <filesystem>
+#include <unordered_map>
+#include <mutex>
+#include <algorithm>
+#include <system_error>
+#include <cctype>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+struct RegistryState {
+    std::mutex mutex;
+    std::unordered_map<std::string, std::weak_ptr<TextureResource>> entries;
+    bool shutDown = false;
+};
+
+RegistryState& registryState() {
+    static RegistryState state;
+    return state;
+}
+
+// 未压缩内部格式的每像素字节数（RGB8 在多数驱动上按 4 字节存储）
+size_t bytesPerPixel(GLint internalFormat) {
+    switch (internalFormat) {
+    case GL_RED:
+    case GL_R8:
+        return 1;
+    case GL_RG:
+    case GL_RG8:
+        return 2;
+    case GL_RGBA16F:
+        return 8;
+    case GL_RGBA32F:
+        return 16;
+    default:
+        return 4;
+    }
+}
+
+std::string optionsKey(const TextureLoadOptions& options) {
+    return "|wrap=" + std::to_string(options.wrap) + "|mip=" + (options.mipmaps ? "1" : "0");
+}
+
+} // namespace
+
+TextureResource::TextureResource(unsigned int id, GLenum target, const std::string& key, const std::string& path)
+    : id(id), target(target), key(key), path(path) {}
+
+TextureResource::~TextureResource() {
+    RegistryState& state = registryState();
+    {
+        std::lock_guard<std::mutex> lock(state.mutex);
+        auto it = state.entries.find(key);
+        if (it != state.entries.end() && it->second.expired()) {
+            state.entries.erase(it);
+        }
+        if (state.shutDown) return; // GL 纹理已在 shutdownTextureRegistry 中删除
+    }
+    cancelTextureLoad(id);
+    glDeleteTextures(1, &id);
+}
+
+std::string normalizeTexturePath(const std::string& path) {
+    std::error_code ec;
+    fs::path normalized = fs::weakly_canonical(fs::path(path), ec);
+    if (ec) {
+        normalized = fs::path(path).lexically_normal();
+    }
+    std::string result = normalized.generic_string();
+#ifdef _WIN32
+    std::transform(result.begin(), result.end(), result.begin(),
+        [](unsigned char c) { return (char)std::tolower(c); });
+#endif
+    return result;
+}
+
+TextureHandle acquireTexture(const std::string& path, const TextureLoadOptions& options) {
+    RegistryState& state = registryState();
+    std::string normalized = normalizeTexturePath(path);
+    std::string key = normalized + optionsKey(options);
+
+    std::lock_guard<std::mutex> lock(state.mutex);
+    auto it = state.entries.find(key);
+    if (it != state.entries.end()) {
+        if (TextureHandle existing = it->second.lock()) {
+            return existing;
+        }
+    }
+
+    unsigned int id = loadTextureAsync(path.c_str());
+    if (options.wrap != GL_REPEAT || !options.mipmaps) {
+        glBindTexture(GL_TEXTURE_2D, id);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, options.wrap);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, options.wrap);
+        if (!options.mipmaps) {
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        }
+        glBindTexture(GL_TEXTURE_2D, 0);
+    }
+
+    TextureHandle handle = std::make_shared<TextureResource>(id, GL_TEXTURE_2D, key, normalized);
+    state.entries[key] = handle;
+    return handle;
+}
+
+TextureHandle acquireCubemap(const std::vector<std::string>& faces) {
+    RegistryState& state = registryState();
+    std::string key = "cubemap:";
+    for (const std::string& face : faces) {
+        key += normalizeTexturePath(face) + ";";
+    }
+
+    std::lock_guard<std::mutex> lock(state.mutex);
+    auto it = state.entries.find(key);
+    if (it != state.entries.end()) {
+        if (TextureHandle existing = it->second.lock()) {
+            return existing;
+        }
+    }
+
+    unsigned int id = loadCubemapAsync(faces);
+    std::string path = faces.empty() ? std::string() : normalizeTexturePath(faces[0]);
+    TextureHandle handle = std::make_shared<TextureResource>(id, GL_TEXTURE_CUBE_MAP, key, path);
+    state.entries[key] = handle;
+    return handle;
+}
+
+TextureHandle acquireTextureArray(const std::vector<std::string>& layers, int maxLayerSize) {
+    RegistryState& state = registryState();
+    std::string key = "array:" + std::to_string(maxLayerSize) + ":";
+    for (const std::string& layer : layers) {
+        key += normalizeTexturePath(layer) + ";";
+    }
+
+    std::lock_guard<std::mutex> lock(state.mutex);
+    auto it = state.entries.find(key);
+    if (it != state.entries.end()) {
+        if (TextureHandle existing = it->second.lock()) {
+            return existing;
+        }
+    }
+
+    unsigned int id = loadTextureArrayAsync(layers, maxLayerSize);
+    std::string path = layers.empty() ? std::string() : normalizeTexturePath(layers[0]);
+    TextureHandle handle = std::make_shared<TextureResource>(id, GL_TEXTURE_2D_ARRAY, key, path);
+    state.entries[key] = handle;
+    return handle;
+}
+
+std::vector<size_t> queryTextureLevelMemory(unsigned int id, GLenum target, int* width, int* height) {
+    GLenum levelTarget = (target == GL_TEXTURE_CUBE_MAP) ? GL_TEXTURE_CUBE_MAP_POSITIVE_X : target;
+    size_t faces = (target == GL_TEXTURE_CUBE_MAP) ? 6 : 1;
+    std::vector<size_t> levels;
+    if (width) *width = 0;
+    if (height) *height = 0;
+
+    glBindTexture(target, id);
+    if (target == GL_TEXTURE_2D_ARRAY) {
+        GLint layers = 1;
+        glGetTexLevelParameteriv(levelTarget, 0, GL_TEXTURE_DEPTH, &layers);
+        faces = (size_t)std::max(layers, 1);
+    }
+    for (GLint level = 0; level < 16; level++) {
+        GLint w = 0, h = 0, compressed = 0;
+        glGetTexLevelParameteriv(levelTarget, level, GL_TEXTURE_WIDTH, &w);
+        glGetTexLevelParameteriv(levelTarget, level, GL_TEXTURE_HEIGHT, &h);
+        levels.push_back(0);
+        if (w == 0 || h == 0) continue; // 渐进上传中 / 已降级的纹理高分辨率级别可能未定义
+        if (width && *width == 0) {
+            *width = w;
+            if (height) *height = h;
+        }
+
+        glGetTexLevelParameteriv(levelTarget, level, GL_TEXTURE_COMPRESSED, &compressed);
+        if (compressed) {
+            GLint size = 0;
+            glGetTexLevelParameteriv(levelTarget, level, GL_TEXTURE_COMPRESSED_IMAGE_SIZE, &size);
+            levels.back() = (size_t)size * faces;
+        } else {
+            GLint internalFormat = 0;
+            glGetTexLevelParameteriv(levelTarget, level, GL_TEXTURE_INTERNAL_FORMAT, &internalFormat);
+            levels.back() = (size_t)w * h * bytesPerPixel(internalFormat) * faces;
+        }
+    }
+    glBindTexture(target, 0);
+
+    while (!levels.empty() && levels.back() == 0) levels.pop_back();
+    return levels;
+}
+
+std::vector<TextureHandle> getLiveTextures() {
+    RegistryState& state = registryState();
+    std::vector<TextureHandle> live;
+    std::lock_guard<std::mutex> lock(state.mutex);
+    for (auto& entry : state.entries) {
+        if (TextureHandle handle = entry.second.lock()) {
+            live.push_back(handle);
+        }
+    }
+    return live;
+}
+
+std::vector<TextureRecord> getTextureRecords() {
+    std::vector<TextureHandle> live = getLiveTextures();
+    std::vector<TextureRecord> records;
+    for (const TextureHandle& handle : live) {
+        TextureRecord record;
+        record.path = handle->path;
+        record.id = handle->id;
+        record.references = handle.use_count() - 1; // 不计本函数持有的引用
+        record.loading = isTextureLoading(handle->id);
+        for (size_t bytes : queryTextureLevelMemory(handle->id, handle->target, &record.width, &record.height)) {
+            record.vramBytes += bytes;
+        }
+        records.push_back(record);
+    }
+    std::sort(records.begin(), records.end(),
+        [](const TextureRecord& a, const TextureRecord& b) { return a.vramBytes > b.vramBytes; });
+    return records;
+}
+
+size_t getTextureMemoryUsage() {
+    size_t total = 0;
+    for (const TextureRecord& record : getTextureRecords()) {
+        total += record.vramBytes;
+    }
+    return total;
+}
+
+void shutdownTextureRegistry() {
+    RegistryState& state = registryState();
+    std::vector<TextureHandle> live;
+    {
+        std::lock_guard<std::mutex> lock(state.mutex);
+        for (auto& entry : state.entries) {
+            if (TextureHandle handle = entry.second.lock()) {
+                live.push_back(handle);
+            }
+        }
+        state.shutDown = true;
+    }
+    for (const TextureHandle& handle : live) {
+        cancelTextureLoad(handle->id);
+        glDeleteTextures(1, &handle->id);
+    }
+}
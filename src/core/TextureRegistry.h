@@ -0,0 +1,64 @@
+#ifndef TEXTURE_REGISTRY_H
+#define TEXTURE_REGISTRY_H
+
+#include <glad/glad.h>
+#include <memory>
+#include <string>
+#include <vector>
+#include <cstddef>
+
+// 纹理加载选项（参与去重键）
+struct TextureLoadOptions {
+    GLenum wrap = GL_REPEAT;
+    bool mipmaps = true;
+};
+
+// 注册表中的一份纹理；最后一个句柄释放时删除 GL 纹理
+class TextureResource {
+public:
+    TextureResource(unsigned int id, GLenum target, const std::string& key, const std::string& path);
+    ~TextureResource();
+    TextureResource(const TextureResource&) = delete;
+    TextureResource& operator=(const TextureResource&) = delete;
+
+    unsigned int id;
+    GLenum target;
+    std::string key;  // 规范化路径 + 选项
+    std::string path; // 规范化路径（立方体贴图 / 纹理数组为第一个面 / 层）
+};
+
+using TextureHandle = std::shared_ptr<TextureResource>;
+
+// 按规范化路径与选项去重，返回共享句柄（纹理异步加载，句柄立即可用）
+TextureHandle acquireTexture(const std::string& path, const TextureLoadOptions& options = TextureLoadOptions());
+TextureHandle acquireCubemap(const std::vector<std::string>& faces);
+TextureHandle acquireTextureArray(const std::vector<std::string>& layers, int maxLayerSize = 1024);
+
+// 规范化路径：解析 . / .. 与相对路径，统一分隔符（Windows 下忽略大小写）
+std::string normalizeTexturePath(const std::string& path);
+
+// 纹理显存统计（查询 GL 的各级 mipmap 尺寸与内部格式）
+struct TextureRecord {
+    std::string path;
+    unsigned int id = 0;
+    long references = 0;
+    int width = 0;
+    int height = 0;
+    size_t vramBytes = 0;
+    bool loading = false;
+};
+
+std::vector<TextureRecord> getTextureRecords();
+
+// 当前存活的所有纹理
+std::vector<TextureHandle> getLiveTextures();
+
+// 逐级查询显存占用（下标为 mip 级别，未定义的级别为 0；立方体贴图 / 纹理数组已乘以面数 / 层数）
+// width / height 输出已定义的最高分辨率级别尺寸
+std::vector<size_t> queryTextureLevelMemory(unsigned int id, GLenum target, int* width = nullptr, int* height = nullptr);
+size_t getTextureMemoryUsage();
+
+// 退出前调用（需要 GL 上下文）：删除所有仍存活的纹理，之后释放的句柄不再调用 GL
+void shutdownTextureRegistry();
+
+#endif // TEXTURE_REGISTRY_H
@@ -0,0 +1,221 @@
+#include "TextureResidency.h"
+#include "AsyncTexture.h"
+#include <glad/glad.h>
+#include <iostream>
+#include <unordered_map>
+#include <algorithm>
+#include <memory>
+
+namespace {
+
+const int kMinimumResidentSize = 64;       // 降级下限：不超过该尺寸的级别始终驻留
+const double kRestoreHeadroom = 0.9;      // 恢复后总量不超过预算的 90%，避免降级 / 恢复来回切换
+
+struct ResidencyEntry {
+    std::weak_ptr<TextureResource> texture;
+    GLenum target = GL_TEXTURE_2D;
+    std::string path;
+    std::vector<size_t> levelBytes; // 各级显存（未驻留级别按下一级 × 4 估算）
+    int residentLevel = 0;
+    int minLevel = 0;               // 可降级到的最低分辨率级别
+    int width = 0;                  // 第 0 级尺寸
+    int height = 0;
+    uint64_t lastUsed = 0;
+    bool measured = false;
+    bool loading = false;
+
+    bool managed() const { return target == GL_TEXTURE_2D; }
+
+    size_t residentBytes() const {
+        size_t total = 0;
+        for (size_t level = (size_t)residentLevel; level < levelBytes.size(); level++) {
+            total += levelBytes[level];
+        }
+        return total;
+    }
+};
+
+struct ResidencyState {
+    std::unordered_map<unsigned int, ResidencyEntry> entries;
+    size_t budget = 512ull * 1024 * 1024;
+    uint64_t frame = 1;
+};
+
+ResidencyState& residencyState() {
+    static ResidencyState state;
+    return state;
+}
+
+ResidencyEntry& entryFor(ResidencyState& state, const TextureHandle& texture) {
+    ResidencyEntry& entry = state.entries[texture->id];
+    if (entry.texture.lock() != texture) {
+        // 新纹理（或 GL 复用了已删除纹理的名字）
+        entry = ResidencyEntry();
+        entry.texture = texture;
+        entry.target = texture->target;
+        entry.path = texture->path;
+        entry.lastUsed = state.frame;
+    }
+    return entry;
+}
+
+// 加载 / 恢复完成后查询实际驻留的级别
+void measure(ResidencyEntry& entry, unsigned int id) {
+    int width = 0, height = 0;
+    std::vector<size_t> resident = queryTextureLevelMemory(id, entry.target, &width, &height);
+    entry.residentLevel = 0;
+    while (entry.residentLevel < (int)resident.size() && resident[entry.residentLevel] == 0) {
+        entry.residentLevel++;
+    }
+
+    std::vector<size_t> known = entry.levelBytes;
+    entry.levelBytes = resident;
+    for (int level = entry.residentLevel - 1; level >= 0; level--) {
+        bool haveKnown = level < (int)known.size() && known[level] > 0;
+        entry.levelBytes[level] = haveKnown ? known[level] : entry.levelBytes[level + 1] * 4;
+    }
+
+    entry.width = width << entry.residentLevel;
+    entry.height = height << entry.residentLevel;
+    entry.minLevel = 0;
+    while (entry.minLevel < (int)entry.levelBytes.size() - 1
+        && std::max(entry.width >> entry.minLevel, entry.height >> entry.minLevel) > kMinimumResidentSize) {
+        entry.minLevel++;
+    }
+    entry.measured = true;
+}
+
+// 降级：上调 BASE_LEVEL，并把被丢弃的级别重新定义为空图像以释放显存
+void dropTopLevels(unsigned int id, int oldBase, int newBase) {
+    glBindTexture(GL_TEXTURE_2D, id);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, newBase);
+    for (int level = oldBase; level < newBase; level++) {
+        glTexImage2D(GL_TEXTURE_2D, level, GL_RGBA8, 0, 0, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    }
+    glBindTexture(GL_TEXTURE_2D, 0);
+}
+
+} // namespace
+
+void setTextureBudget(size_t bytes) {
+    residencyState().budget = bytes;
+}
+
+size_t getTextureBudget() {
+    return residencyState().budget;
+}
+
+void markTextureUsed(const TextureHandle& texture) {
+    if (!texture) return;
+    ResidencyState& state = residencyState();
+    entryFor(state, texture).lastUsed = state.frame;
+}
+
+void updateTextureResidency() {
+    ResidencyState& state = residencyState();
+
+    // 与注册表同步：登记新纹理，移除已释放的纹理
+    std::vector<TextureHandle> live = getLiveTextures();
+    for (const TextureHandle& texture : live) {
+        entryFor(state, texture);
+    }
+    for (auto it = state.entries.begin(); it != state.entries.end();) {
+        if (it->second.texture.expired()) it = state.entries.erase(it);
+        else ++it;
+    }
+
+    size_t total = 0;
+    for (auto& item : state.entries) {
+        ResidencyEntry& entry = item.second;
+        entry.loading = isTextureLoading(item.first);
+        if (entry.loading) {
+            entry.measured = false;
+        } else if (!entry.measured) {
+            measure(entry, item.first);
+        }
+        total += entry.residentBytes();
+    }
+
+    std::vector<std::pair<unsigned int, ResidencyEntry*>> candidates;
+    for (auto& item : state.entries) {
+        ResidencyEntry& entry = item.second;
+        if (entry.managed() && entry.measured && !entry.loading) {
+            candidates.push_back({ item.first, &entry });
+        }
+    }
+
+    if (total > state.budget) {
+        // 超出预算：最久未使用的纹理先降级，同样久未使用时先降最大的
+        std::sort(candidates.begin(), candidates.end(), [](const auto& a, const auto& b) {
+            if (a.second->lastUsed != b.second->lastUsed) return a.second->lastUsed < b.second->lastUsed;
+            return a.second->residentBytes() > b.second->residentBytes();
+        });
+        for (auto& candidate : candidates) {
+            ResidencyEntry& entry = *candidate.second;
+            int oldBase = entry.residentLevel;
+            while (entry.residentLevel < entry.minLevel && total > state.budget) {
+                total -= entry.levelBytes[entry.residentLevel];
+                entry.residentLevel++;
+            }
+            if (entry.residentLevel != oldBase) {
+                dropTopLevels(candidate.first, oldBase, entry.residentLevel);
+                std::cout << "[Residency] Downgraded to mip " << entry.residentLevel << ": " << entry.path << std::endl;
+            }
+            if (total <= state.budget) break;
+        }
+    } else {
+        // 预算有余量：恢复本帧用到的已降级纹理（最近使用的优先）
+        size_t limit = (size_t)(state.budget * kRestoreHeadroom);
+        for (auto& candidate : candidates) {
+            ResidencyEntry& entry = *candidate.second;
+            if (entry.lastUsed != state.frame || entry.residentLevel == 0) continue;
+
+            int target = entry.residentLevel;
+            while (target > 0 && total + entry.levelBytes[target - 1] <= limit) {
+                total += entry.levelBytes[target - 1];
+                target--;
+            }
+            if (target < entry.residentLevel) {
+                restoreTextureAsync(candidate.first, entry.path, target);
+                entry.loading = true;
+                entry.measured = false;
+            }
+        }
+    }
+
+    state.frame++;
+}
+
+std::vector<TextureResidencyRecord> getTextureResidency() {
+    ResidencyState& state = residencyState();
+    std::vector<TextureResidencyRecord> records;
+    for (auto& item : state.entries) {
+        const ResidencyEntry& entry = item.second;
+        TextureResidencyRecord record;
+        record.path = entry.path;
+        record.id = item.first;
+        record.width = std::max(1, entry.width >> entry.residentLevel);
+        record.height = std::max(1, entry.height >> entry.residentLevel);
+        record.residentLevel = entry.residentLevel;
+        record.levelCount = (int)entry.levelBytes.size();
+        record.residentBytes = entry.residentBytes();
+        for (size_t bytes : entry.levelBytes) {
+            record.fullBytes += bytes;
+        }
+        record.framesSinceUse = (state.frame > entry.lastUsed + 1) ? state.frame - entry.lastUsed - 1 : 0;
+        record.loading = entry.loading;
+        record.managed = entry.managed();
+        records.push_back(record);
+    }
+    std::sort(records.begin(), records.end(),
+        [](const TextureResidencyRecord& a, const TextureResidencyRecord& b) { return a.fullBytes > b.fullBytes; });
+    return records;
+}
+
+size_t getResidentTextureMemory() {
+    size_t total = 0;
+    for (auto& item : residencyState().entries) {
+        total += item.second.residentBytes();
+    }
+    return total;
+}
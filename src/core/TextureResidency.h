@@ -0,0 +1,40 @@
+#ifndef TEXTURE_RESIDENCY_H
+#define TEXTURE_RESIDENCY_H
+
+#include "TextureRegistry.h"
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+// 纹理驻留管理：按 mip 级别估算注册表中每张纹理的显存，总量超出预算时
+// 从最久未使用的 2D 纹理开始丢弃高分辨率 mip（降级，最低保留 64x64 以下的级别，纹理始终可采样），
+// 纹理再次被使用且预算有余量时异步恢复。立方体贴图与纹理数组只计入总量，不做降级
+
+void setTextureBudget(size_t bytes);
+size_t getTextureBudget();
+
+// 绘制时调用：记录纹理本帧被使用（LRU 依据）
+void markTextureUsed(const TextureHandle& texture);
+
+// 每帧绘制结束后调用（主线程）：执行降级与恢复
+void updateTextureResidency();
+
+struct TextureResidencyRecord {
+    std::string path;
+    unsigned int id = 0;
+    int width = 0;            // 当前驻留的最高分辨率级别尺寸
+    int height = 0;
+    int residentLevel = 0;    // 当前 GL_TEXTURE_BASE_LEVEL
+    int levelCount = 0;
+    size_t residentBytes = 0;
+    size_t fullBytes = 0;     // 全部级别驻留时的显存（未驻留级别为估算值）
+    uint64_t framesSinceUse = 0;
+    bool loading = false;     // 首次加载或恢复中
+    bool managed = false;     // 可降级（2D 纹理）
+};
+
+std::vector<TextureResidencyRecord> getTextureResidency();
+size_t getResidentTextureMemory();
+
+#endif // TEXTURE_RESIDENCY_H
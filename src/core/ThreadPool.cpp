@@ -0,0 +1,106 @@
+#include "ThreadPool.h"
+#include <atomic>
+#include <memory>
+#include <algorithm>
+
+ThreadPool::ThreadPool(unsigned int threadCount)
+    : activeTasks(0), stopping(false) {
+    if (threadCount == 0) {
+        unsigned int hardwareThreads = std::thread::hardware_concurrency();
+        threadCount = hardwareThreads > 1 ? hardwareThreads - 1 : 1;
+    }
+    for (unsigned int i = 0; i < threadCount; i++) {
+        workers.emplace_back(&ThreadPool::workerLoop, this);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    taskAvailable.notify_all();
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+}
+
+void ThreadPool::submit(std::function<void()> task) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        tasks.push(std::move(task));
+    }
+    taskAvailable.notify_one();
+}
+
+void ThreadPool::parallelFor(size_t count, const std::function<void(size_t)>& task) {
+    if (count == 0) return;
+    if (count == 1) {
+        task(0);
+        return;
+    }
+
+    // 共享状态用 shared_ptr 持有：尚未开始的辅助任务在本函数返回后仍可能被执行
+    struct State {
+        std::atomic<size_t> next{ 0 };
+        size_t completed = 0;
+        std::mutex mutex;
+        std::condition_variable done;
+    };
+    auto state = std::make_shared<State>();
+    const std::function<void(size_t)>* taskPtr = &task;
+
+    auto run = [state, count, taskPtr]() {
+        size_t finished = 0;
+        for (size_t i = state->next++; i < count; i = state->next++) {
+            (*taskPtr)(i);
+            finished++;
+        }
+        if (finished > 0) {
+            std::lock_guard<std::mutex> lock(state->mutex);
+            state->completed += finished;
+            if (state->completed == count) state->done.notify_all();
+        }
+    };
+
+    size_t helpers = std::min<size_t>(count - 1, workers.size());
+    for (size_t i = 0; i < helpers; i++) {
+        submit(run);
+    }
+    run();
+
+    std::unique_lock<std::mutex> lock(state->mutex);
+    state->done.wait(lock, [&]() { return state->completed == count; });
+}
+
+void ThreadPool::waitIdle() {
+    std::unique_lock<std::mutex> lock(mutex);
+    idle.wait(lock, [this]() { return tasks.empty() && activeTasks == 0; });
+}
+
+void ThreadPool::workerLoop() {
+    while (true) {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            taskAvailable.wait(lock, [this]() { return stopping || !tasks.empty(); });
+            if (stopping && tasks.empty()) return;
+            task = std::move(tasks.front());
+            tasks.pop();
+            activeTasks++;
+        }
+
+        task();
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            activeTasks--;
+            if (tasks.empty() && activeTasks == 0) idle.notify_all();
+        }
+    }
+}
+
+ThreadPool& getThreadPool() {
+    static ThreadPool pool;
+    return pool;
+}
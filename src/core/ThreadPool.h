@@ -0,0 +1,47 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <queue>
+#include <vector>
+#include <cstddef>
+
+// 固定大小的工作线程池（纹理解码、模型解析等后台任务共用）
+class ThreadPool {
+public:
+    // threadCount 为 0 时使用 硬件线程数 - 1（至少 1 个）
+    explicit ThreadPool(unsigned int threadCount = 0);
+    ~ThreadPool();
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    void submit(std::function<void()> task);
+
+    // 在线程池与调用线程上并行执行 task(0..count-1)，全部完成后返回
+    // 调用线程也参与执行，因此可以在工作线程内嵌套调用
+    void parallelFor(size_t count, const std::function<void(size_t)>& task);
+
+    // 等待队列清空且所有任务执行完毕
+    void waitIdle();
+
+    unsigned int size() const { return (unsigned int)workers.size(); }
+
+private:
+    void workerLoop();
+
+    std::vector<std::thread> workers;
+    std::queue<std::function<void()>> tasks;
+    std::mutex mutex;
+    std::condition_variable taskAvailable;
+    std::condition_variable idle;
+    size_t activeTasks;
+    bool stopping;
+};
+
+// 全局共享线程池（首次调用时创建）
+ThreadPool& getThreadPool();
+
+#endif // THREAD_POOL_H
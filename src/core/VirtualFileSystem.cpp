@@ -0,0 +1,245 @@
+#include "VirtualFileSystem.h"
+#include "AssetArchive.h"
+#include <filesystem>
+#include <iostream>
+#include <mutex>
+#include <algorithm>
+#include <cstring>
+#include <system_error>
+
+namespace fs = std::filesystem;
+
+// 一个已映射的资源包：索引按路径排序，查找为二分
+class MountedArchive {
+public:
+    std::string path;
+    MappedFile file;
+    const ArchiveEntry* entries = nullptr;
+    size_t entryCount = 0;
+    const char* strings = nullptr;
+
+    std::string name(const ArchiveEntry& entry) const {
+        return std::string(strings + entry.nameOffset, entry.nameLength);
+    }
+
+    int compare(const ArchiveEntry& entry, const std::string& key) const {
+        size_t length = std::min<size_t>(entry.nameLength, key.size());
+        int result = std::memcmp(strings + entry.nameOffset, key.data(), length);
+        if (result != 0) return result;
+        return (entry.nameLength < key.size()) ? -1 : (entry.nameLength > key.size() ? 1 : 0);
+    }
+
+    const ArchiveEntry* find(const std::string& key) const {
+        size_t lo = 0, hi = entryCount;
+        while (lo < hi) {
+            size_t mid = (lo + hi) / 2;
+            int result = compare(entries[mid], key);
+            if (result == 0) return &entries[mid];
+            if (result < 0) lo = mid + 1;
+            else hi = mid;
+        }
+        return nullptr;
+    }
+};
+
+namespace {
+
+struct VfsState {
+    std::mutex mutex;
+    std::vector<std::shared_ptr<const MountedArchive>> archives;
+};
+
+VfsState& vfsState() {
+    static VfsState state;
+    return state;
+}
+
+// 包内路径相对于工作目录：绝对路径先转换为相对路径再规范化
+std::string archiveKey(const std::string& path) {
+    fs::path p(path);
+    if (p.is_absolute()) {
+        std::error_code ec;
+        fs::path relative = p.lexically_relative(fs::current_path(ec));
+        if (!ec && !relative.empty() && *relative.begin() != "..") p = relative;
+    }
+    return normalizeArchivePath(p.generic_string());
+}
+
+bool validateArchive(const MappedFile& file, const ArchiveHeader& header) {
+    if (header.magic != kArchiveMagic || header.version != kArchiveVersion) return false;
+    uint64_t size = file.size();
+    if (header.indexOffset % 8 != 0 || header.indexOffset > size
+        || header.entryCount > (size - header.indexOffset) / sizeof(ArchiveEntry)) return false;
+    if (header.stringsOffset != header.indexOffset + (uint64_t)header.entryCount * sizeof(ArchiveEntry)
+        || header.stringsSize > size - header.stringsOffset) return false;
+
+    const ArchiveEntry* entries = reinterpret_cast<const ArchiveEntry*>(file.data() + header.indexOffset);
+    for (uint32_t i = 0; i < header.entryCount; i++) {
+        const ArchiveEntry& entry = entries[i];
+        if (entry.offset > size || entry.storedSize > size - entry.offset) return false;
+        if ((uint64_t)entry.nameOffset + entry.nameLength > header.stringsSize) return false;
+        if (entry.compression == (uint32_t)ArchiveCompression::None && entry.storedSize != entry.size) return false;
+    }
+    return true;
+}
+
+// 查找顺序与挂载顺序相反，后挂载的资源包覆盖先挂载的
+std::shared_ptr<const MountedArchive> findEntry(const std::string& path, const ArchiveEntry*& entry) {
+    VfsState& state = vfsState();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    if (state.archives.empty()) return nullptr;
+    std::string key = archiveKey(path);
+    for (auto it = state.archives.rbegin(); it != state.archives.rend(); ++it) {
+        entry = (*it)->find(key);
+        if (entry) return *it;
+    }
+    return nullptr;
+}
+
+} // namespace
+
+VirtualFile::VirtualFile() : fileData(nullptr), fileSize(0), opened(false) {}
+
+VirtualFile::~VirtualFile() {
+    close();
+}
+
+bool VirtualFile::open(const std::string& path) {
+    close();
+
+    const ArchiveEntry* entry = nullptr;
+    std::shared_ptr<const MountedArchive> mounted = findEntry(path, entry);
+    if (mounted) {
+        ArchiveCompression compression = (ArchiveCompression)entry->compression;
+        const uint8_t* stored = mounted->file.data() + entry->offset;
+        if (compression == ArchiveCompression::None) {
+            fileData = stored;
+        } else {
+            buffer.resize((size_t)entry->size);
+            if (!decompressArchiveEntry(compression, stored, (size_t)entry->storedSize, buffer.data(), buffer.size())) {
+                std::cerr << "[VFS] Cannot decompress " << mounted->name(*entry) << " ("
+                    << getArchiveCompressionName(compression) << ") in " << mounted->path << std::endl;
+                buffer.clear();
+                return false;
+            }
+            fileData = buffer.data();
+        }
+        fileSize = (size_t)entry->size;
+        archive = mounted;
+        opened = true;
+        return true;
+    }
+
+    // 散文件：MappedFile 不映射空文件，空文件按长度为 0 的文件打开
+    if (looseFile.open(path)) {
+        fileData = looseFile.data();
+        fileSize = looseFile.size();
+        opened = true;
+        return true;
+    }
+    std::error_code ec;
+    if (fs::is_regular_file(path, ec) && fs::file_size(path, ec) == 0 && !ec) {
+        opened = true;
+        return true;
+    }
+    return false;
+}
+
+void VirtualFile::close() {
+    looseFile.close();
+    archive.reset();
+    buffer.clear();
+    buffer.shrink_to_fit();
+    fileData = nullptr;
+    fileSize = 0;
+    opened = false;
+}
+
+bool mountArchive(const std::string& path) {
+    auto archive = std::make_shared<MountedArchive>();
+    archive->path = path;
+    if (!archive->file.open(path)) {
+        std::cerr << "[VFS] Cannot open archive: " << path << std::endl;
+        return false;
+    }
+
+    ArchiveHeader header;
+    if (archive->file.size() < sizeof(header)) {
+        std::cerr << "[VFS] Invalid archive: " << path << std::endl;
+        return false;
+    }
+    std::memcpy(&header, archive->file.data(), sizeof(header));
+    if (!validateArchive(archive->file, header)) {
+        std::cerr << "[VFS] Invalid archive: " << path << std::endl;
+        return false;
+    }
+
+    archive->entries = reinterpret_cast<const ArchiveEntry*>(archive->file.data() + header.indexOffset);
+    archive->entryCount = header.entryCount;
+    archive->strings = reinterpret_cast<const char*>(archive->file.data() + header.stringsOffset);
+
+    size_t compressed = 0, unsupported = 0;
+    for (size_t i = 0; i < archive->entryCount; i++) {
+        ArchiveCompression compression = (ArchiveCompression)archive->entries[i].compression;
+        if (compression != ArchiveCompression::None) compressed++;
+        if (!isArchiveCompressionSupported(compression)) unsupported++;
+    }
+    if (unsupported > 0) {
+        std::cerr << "[VFS] " << unsupported << " entries in " << path
+            << " use a compression this build does not support" << std::endl;
+    }
+
+    VfsState& state = vfsState();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    state.archives.push_back(archive);
+    std::cout << "[VFS] Mounted " << path << ": " << archive->entryCount << " entries ("
+        << compressed << " compressed)" << std::endl;
+    return true;
+}
+
+void unmountArchives() {
+    VfsState& state = vfsState();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    state.archives.clear();
+}
+
+size_t getMountedArchiveCount() {
+    VfsState& state = vfsState();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    return state.archives.size();
+}
+
+bool findPackedFile(const std::string& path, PackedFileInfo& info) {
+    const ArchiveEntry* entry = nullptr;
+    if (!findEntry(path, entry)) return false;
+    info.size = entry->size;
+    info.mtime = entry->mtime;
+    info.hash = entry->hash;
+    return true;
+}
+
+bool locatePackedFile(const std::string& path, PackedFileLocation& location) {
+    const ArchiveEntry* entry = nullptr;
+    std::shared_ptr<const MountedArchive> archive = findEntry(path, entry);
+    if (!archive) return false;
+    location.archivePath = archive->path;
+    location.offset = entry->offset;
+    location.storedSize = entry->storedSize;
+    location.size = entry->size;
+    location.compression = entry->compression;
+    return true;
+}
+
+bool virtualFileExists(const std::string& path) {
+    const ArchiveEntry* entry = nullptr;
+    if (findEntry(path, entry)) return true;
+    std::error_code ec;
+    return fs::is_regular_file(path, ec);
+}
+
+bool readVirtualTextFile(const std::string& path, std::string& text) {
+    VirtualFile file;
+    if (!file.open(path)) return false;
+    text.assign(reinterpret_cast<const char*>(file.data()), file.size());
+    return true;
+}
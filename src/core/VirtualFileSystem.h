@@ -0,0 +1,70 @@
+#ifndef VIRTUAL_FILE_SYSTEM_H
+#define VIRTUAL_FILE_SYSTEM_H
+
+#include "MappedFile.h"
+#include <memory>
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+class MountedArchive;
+
+// 只读虚拟文件：未压缩的包内条目直接指向资源包的映射内存（零拷贝），
+// 压缩条目解压到自有缓冲区，散文件通过内存映射打开
+class VirtualFile {
+public:
+    VirtualFile();
+    ~VirtualFile();
+    VirtualFile(const VirtualFile&) = delete;
+    VirtualFile& operator=(const VirtualFile&) = delete;
+
+    bool open(const std::string& path);
+    void close();
+
+    bool isOpen() const { return opened; }
+    const uint8_t* data() const { return fileData; }
+    size_t size() const { return fileSize; }
+    bool isPacked() const { return archive != nullptr; }
+
+private:
+    const uint8_t* fileData;
+    size_t fileSize;
+    bool opened;
+    std::shared_ptr<const MountedArchive> archive; // 保证关闭前资源包不被卸载
+    std::vector<uint8_t> buffer;
+    MappedFile looseFile;
+};
+
+// 包内条目信息（大小 / 修改时间 / 内容哈希在打包时记录）
+struct PackedFileInfo {
+    uint64_t size = 0;
+    int64_t mtime = 0;
+    uint64_t hash = 0;
+};
+
+// 包内条目在资源包文件中的位置（供异步读取直接按偏移读取，读完后自行解压）
+struct PackedFileLocation {
+    std::string archivePath;
+    uint64_t offset = 0;
+    uint64_t storedSize = 0;
+    uint64_t size = 0;
+    uint32_t compression = 0; // ArchiveCompression
+};
+
+// 挂载资源包；后挂载的优先查找。查找顺序：资源包 -> 散文件（开发时直接读取 objects/ 与 shaders/）
+bool mountArchive(const std::string& path);
+void unmountArchives();
+size_t getMountedArchiveCount();
+
+// 在已挂载的资源包中查找（不访问磁盘上的散文件）
+bool findPackedFile(const std::string& path, PackedFileInfo& info);
+bool locatePackedFile(const std::string& path, PackedFileLocation& location);
+
+// 资源包或散文件中是否存在
+bool virtualFileExists(const std::string& path);
+
+// 读取整个文件为字符串（着色器、MTL 等文本资源）
+bool readVirtualTextFile(const std::string& path, std::string& text);
+
+#endif // VIRTUAL_FILE_SYSTEM_H
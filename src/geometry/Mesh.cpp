@@ -1,4 +1,228 @@
 #include "Mesh.h"
+#include <glm/gtc/packing.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
 
-Mesh::Mesh() : VAO(0), VBO(0), EBO(0), indexCount(0) {}
+Mesh::Mesh()
+    : VAO(0), VBO(0), EBO(0), indexCount(0), indexType(GL_UNSIGNED_INT), compact(false)
+    , positionOffset(0.0f), positionScale(1.0f), atlasTiling(false), atlasTile(0.0f, 0.0f, 1.0f, 1.0f)
+    , positionVAO(0), positionVBO(0) {}
 
+glm::vec2 encodeOctahedral(const glm::vec3& normal) {
+    float l1 = std::abs(normal.x) + std::abs(normal.y) + std::abs(normal.z);
+    if (l1 <= 0.0f) return glm::vec2(0.0f);
+
+    glm::vec2 e(normal.x / l1, normal.y / l1);
+    if (normal.z < 0.0f) {
+        // 下半球折叠到外侧三角形
+        glm::vec2 folded((1.0f - std::abs(e.y)) * (e.x >= 0.0f ? 1.0f : -1.0f),
+                         (1.0f - std::abs(e.x)) * (e.y >= 0.0f ? 1.0f : -1.0f));
+        e = folded;
+    }
+    return e;
+}
+
+CompactVertex packVertex(const Vertex& vertex, const glm::vec3& boundsMin, const glm::vec3& boundsExtent) {
+    CompactVertex packed;
+
+    for (int k = 0; k < 3; k++) {
+        float t = boundsExtent[k] > 0.0f ? (vertex.Position[k] - boundsMin[k]) / boundsExtent[k] : 0.0f;
+        packed.Position[k] = glm::packUnorm1x16(t);
+    }
+    packed.Position[3] = 0;
+
+    glm::vec2 oct = encodeOctahedral(vertex.Normal);
+    packed.Normal[0] = (int16_t)glm::packSnorm1x16(oct.x);
+    packed.Normal[1] = (int16_t)glm::packSnorm1x16(oct.y);
+
+    packed.TexCoords[0] = glm::packHalf1x16(vertex.TexCoords.x);
+    packed.TexCoords[1] = glm::packHalf1x16(vertex.TexCoords.y);
+    return packed;
+}
+
+Mesh uploadMesh(const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices,
+    VertexFormat format, bool positionStream) {
+    return uploadMesh(vertices.data(), vertices.size(), indices.data(), indices.size(), format, positionStream);
+}
+
+Mesh uploadMesh(const Vertex* vertices, size_t vertexCount, const unsigned int* indices, size_t indexCount,
+    VertexFormat format, bool positionStream) {
+    return uploadPackedMesh(packMesh(vertices, vertexCount, indices, indexCount, format, positionStream));
+}
+
+PackedMesh packMesh(const Vertex* vertices, size_t vertexCount, const unsigned int* indices, size_t indexCount,
+    VertexFormat format, bool positionStream) {
+    PackedMesh p;
+    if (vertexCount == 0 || indexCount == 0) return p;
+
+    if (format == VertexFormat::Compact) {
+        glm::vec3 boundsMin(vertices[0].Position);
+        glm::vec3 boundsMax(vertices[0].Position);
+        for (size_t i = 0; i < vertexCount; i++) {
+            boundsMin = glm::min(boundsMin, vertices[i].Position);
+            boundsMax = glm::max(boundsMax, vertices[i].Position);
+        }
+        glm::vec3 extent = boundsMax - boundsMin;
+
+        p.vertexData.resize(vertexCount * sizeof(CompactVertex));
+        CompactVertex* packed = reinterpret_cast<CompactVertex*>(p.vertexData.data());
+        for (size_t i = 0; i < vertexCount; i++) {
+            packed[i] = packVertex(vertices[i], boundsMin, extent);
+        }
+        p.compact = true;
+        p.positionOffset = boundsMin;
+        p.positionScale = extent;
+
+        if (positionStream) {
+            // 位置流沿用相同的量化结果，保证深度 pass 与着色 pass 的深度值一致
+            p.positionData.resize(vertexCount * 4 * sizeof(uint16_t));
+            uint16_t* positions = reinterpret_cast<uint16_t*>(p.positionData.data());
+            for (size_t i = 0; i < vertexCount; i++) {
+                std::copy(packed[i].Position, packed[i].Position + 4, positions + i * 4);
+            }
+        }
+    } else {
+        const uint8_t* bytes = reinterpret_cast<const uint8_t*>(vertices);
+        p.vertexData.assign(bytes, bytes + vertexCount * sizeof(Vertex));
+
+        if (positionStream) {
+            p.positionData.resize(vertexCount * sizeof(glm::vec3));
+            glm::vec3* positions = reinterpret_cast<glm::vec3*>(p.positionData.data());
+            for (size_t i = 0; i < vertexCount; i++) {
+                positions[i] = vertices[i].Position;
+            }
+        }
+    }
+
+    // 索引：顶点数少于 65536 时使用 16 位
+    if (vertexCount < 65536) {
+        p.indexData.resize(indexCount * sizeof(uint16_t));
+        uint16_t* shortIndices = reinterpret_cast<uint16_t*>(p.indexData.data());
+        for (size_t i = 0; i < indexCount; i++) {
+            shortIndices[i] = (uint16_t)indices[i];
+        }
+        p.indexType = GL_UNSIGNED_SHORT;
+    } else {
+        const uint8_t* bytes = reinterpret_cast<const uint8_t*>(indices);
+        p.indexData.assign(bytes, bytes + indexCount * sizeof(unsigned int));
+        p.indexType = GL_UNSIGNED_INT;
+    }
+    p.indexCount = indexCount;
+    return p;
+}
+
+// 填充一个网格的缓冲与 VAO（名称由调用方生成；没有位置流时 positionVAO / positionVBO 为 0）
+static void fillMesh(const PackedMesh& p, Mesh& m, GLuint vao, GLuint vbo, GLuint ebo, GLuint positionVAO, GLuint positionVBO) {
+    m.VAO = vao;
+    m.VBO = vbo;
+    m.EBO = ebo;
+    m.compact = p.compact;
+    m.positionOffset = p.positionOffset;
+    m.positionScale = p.positionScale;
+    m.indexType = p.indexType;
+    m.indexCount = (GLsizei)p.indexCount;
+
+    glBindVertexArray(m.VAO);
+    glBindBuffer(GL_ARRAY_BUFFER, m.VBO);
+    glBufferData(GL_ARRAY_BUFFER, (GLsizeiptr)p.vertexData.size(), p.vertexData.data(), GL_STATIC_DRAW);
+    if (m.compact) {
+        // 位置（16 位无符号归一化）
+        glEnableVertexAttribArray(0);
+        glVertexAttribPointer(0, 3, GL_UNSIGNED_SHORT, GL_TRUE, sizeof(CompactVertex),
+            (void*)offsetof(CompactVertex, Position));
+        // 法线（八面体编码，16 位有符号归一化）
+        glEnableVertexAttribArray(1);
+        glVertexAttribPointer(1, 2, GL_SHORT, GL_TRUE, sizeof(CompactVertex),
+            (void*)offsetof(CompactVertex, Normal));
+        // 纹理坐标（半精度浮点）
+        glEnableVertexAttribArray(2);
+        glVertexAttribPointer(2, 2, GL_HALF_FLOAT, GL_FALSE, sizeof(CompactVertex),
+            (void*)offsetof(CompactVertex, TexCoords));
+    } else {
+        glEnableVertexAttribArray(0);
+        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, Position));
+        glEnableVertexAttribArray(1);
+        glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, Normal));
+        glEnableVertexAttribArray(2);
+        glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, TexCoords));
+    }
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m.EBO);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, (GLsizeiptr)p.indexData.size(), p.indexData.data(), GL_STATIC_DRAW);
+
+    // 仅位置流的 VAO：只有属性 0，复用同一个 EBO
+    if (positionVAO != 0) {
+        m.positionVAO = positionVAO;
+        m.positionVBO = positionVBO;
+        glBindVertexArray(m.positionVAO);
+        glBindBuffer(GL_ARRAY_BUFFER, m.positionVBO);
+        glBufferData(GL_ARRAY_BUFFER, (GLsizeiptr)p.positionData.size(), p.positionData.data(), GL_STATIC_DRAW);
+        glEnableVertexAttribArray(0);
+        if (m.compact) {
+            glVertexAttribPointer(0, 3, GL_UNSIGNED_SHORT, GL_TRUE, 4 * sizeof(uint16_t), (void*)0);
+        } else {
+            glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(glm::vec3), (void*)0);
+        }
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m.EBO);
+    }
+}
+
+std::vector<Mesh> uploadPackedMeshes(const std::vector<PackedMesh>& packed) {
+    std::vector<Mesh> meshes(packed.size());
+
+    // 一次生成所有网格的 VAO 与缓冲名称
+    size_t vaoCount = 0, bufferCount = 0;
+    for (const PackedMesh& p : packed) {
+        if (p.indexCount == 0) continue;
+        vaoCount += p.positionData.empty() ? 1 : 2;
+        bufferCount += p.positionData.empty() ? 2 : 3;
+    }
+    if (vaoCount == 0) return meshes;
+    std::vector<GLuint> vaos(vaoCount), buffers(bufferCount);
+    glGenVertexArrays((GLsizei)vaos.size(), vaos.data());
+    glGenBuffers((GLsizei)buffers.size(), buffers.data());
+    size_t nextVao = 0, nextBuffer = 0;
+
+    for (size_t i = 0; i < packed.size(); i++) {
+        const PackedMesh& p = packed[i];
+        if (p.indexCount == 0) continue;
+        GLuint vao = vaos[nextVao++];
+        GLuint vbo = buffers[nextBuffer++];
+        GLuint ebo = buffers[nextBuffer++];
+        GLuint positionVAO = 0, positionVBO = 0;
+        if (!p.positionData.empty()) {
+            positionVAO = vaos[nextVao++];
+            positionVBO = buffers[nextBuffer++];
+        }
+        fillMesh(p, meshes[i], vao, vbo, ebo, positionVAO, positionVBO);
+    }
+
+    glBindVertexArray(0);
+    return meshes;
+}
+
+Mesh uploadPackedMesh(const PackedMesh& packed) {
+    Mesh m;
+    if (packed.indexCount == 0) return m;
+    GLuint vaos[2] = { 0, 0 };
+    GLuint buffers[3] = { 0, 0, 0 };
+    bool positionStream = !packed.positionData.empty();
+    glGenVertexArrays(positionStream ? 2 : 1, vaos);
+    glGenBuffers(positionStream ? 3 : 2, buffers);
+    fillMesh(packed, m, vaos[0], buffers[0], buffers[1], vaos[1], buffers[2]);
+    glBindVertexArray(0);
+    return m;
+}
+
+void releaseMesh(Mesh& mesh) {
+    GLuint vaos[2] = { mesh.VAO, mesh.positionVAO };
+    GLuint buffers[3] = { mesh.VBO, mesh.EBO, mesh.positionVBO };
+    glDeleteVertexArrays(2, vaos); // 名称 0 被忽略
+    glDeleteBuffers(3, buffers);
+    mesh.VAO = mesh.VBO = mesh.EBO = 0;
+    mesh.positionVAO = mesh.positionVBO = 0;
+}
+
+void bindDepthVertexArray(const Mesh& mesh) {
+    glBindVertexArray(mesh.positionVAO != 0 ? mesh.positionVAO : mesh.VAO);
+}
@@ -2,15 +2,102 @@
 #define MESH_H
 
 #include <glad/glad.h>
+#include <glm/glm.hpp>
+#include <vector>
+#include <cstdint>
+#include <string>
+#include "Meshlet.h"
+
+struct Vertex {
+    glm::vec3 Position;
+    glm::vec3 Normal;
+    glm::vec2 TexCoords;
+};
+
+// 紧凑顶点（16 字节）：
+// 位置为相对网格包围盒的 16 位归一化整数，法线为八面体编码的 2x16 位，UV 为半精度浮点
+struct CompactVertex {
+    uint16_t Position[4]; // 第 4 个分量仅用于对齐
+    int16_t Normal[2];
+    uint16_t TexCoords[2];
+};
+
+// CPU 端网格数据（上传 GPU 之前）
+struct MeshData {
+    std::vector<Vertex> vertices;
+    std::vector<unsigned int> indices;
+    unsigned int materialIndex = 0;
+    bool atlasTiling = false;                    // 是否在图集图块内重复采样（体素合并面）
+    glm::vec4 atlasTile = glm::vec4(0, 0, 1, 1); // 图块矩形：xy = 起点，zw = 尺寸
+    std::vector<Meshlet> meshlets;
+};
+
+// 与导入器无关的材质引用
+struct ModelMaterial {
+    std::string name;
+    std::string diffusePath; // 相对模型目录的漫反射贴图路径，为空表示无贴图
+    bool opaque = true;      // 不透明材质才能剔除体素内部面
+};
+
+enum class VertexFormat {
+    Float32, // 3+3+2 float，32 字节
+    Compact  // CompactVertex，16 字节，需要在 basic.vs 中解码
+};
 
 struct Mesh {
     unsigned int VAO;
     unsigned int VBO;
     unsigned int EBO;
     GLsizei indexCount;
+    GLenum indexType;            // GL_UNSIGNED_SHORT（顶点数 < 65536）或 GL_UNSIGNED_INT
+    bool compact;                // 顶点是否为 CompactVertex 格式
+    glm::vec3 positionOffset;    // 紧凑格式的位置解码：pos = offset + q * scale
+    glm::vec3 positionScale;
+    bool atlasTiling;            // 片段着色器在 atlasTile 图块内重复纹理坐标
+    glm::vec4 atlasTile;
+    std::vector<Meshlet> meshlets; // 为空时整体绘制
+    unsigned int positionVAO;    // 仅位置流的 VAO（与 EBO 共享索引），0 表示未创建
+    unsigned int positionVBO;    // 紧密排列的位置流：float3，紧凑格式为 4x16 位归一化整数
 
     Mesh();
 };
 
-#endif // MESH_H
+// 上传前在 CPU 上准备好的 GPU 数据：顶点格式转换、仅位置流与 16 位索引，可在工作线程上生成
+struct PackedMesh {
+    std::vector<uint8_t> vertexData;
+    std::vector<uint8_t> positionData; // 为空表示不创建位置流
+    std::vector<uint8_t> indexData;
+    size_t indexCount = 0;             // 为 0 表示空网格，上传时跳过
+    GLenum indexType = GL_UNSIGNED_INT;
+    bool compact = false;
+    glm::vec3 positionOffset = glm::vec3(0.0f);
+    glm::vec3 positionScale = glm::vec3(1.0f);
+};
+
+PackedMesh packMesh(const Vertex* vertices, size_t vertexCount, const unsigned int* indices, size_t indexCount,
+    VertexFormat format = VertexFormat::Float32, bool positionStream = false);
+
+// 批量上传：一次生成全部 VAO / 缓冲名称后逐个填充，只调用 GL，不再做 CPU 转换
+std::vector<Mesh> uploadPackedMeshes(const std::vector<PackedMesh>& packed);
+Mesh uploadPackedMesh(const PackedMesh& packed);
+
+// 删除网格的 VAO 与缓冲（CPU 端字段保留，可重新上传）
+void releaseMesh(Mesh& mesh);
 
+// 上传顶点与索引到 GPU，建立 VAO（属性位置 0/1/2 = 位置/法线/纹理坐标）
+// 顶点数少于 65536 时自动使用 16 位索引
+// positionStream 为 true 时额外上传仅含位置的顶点流，供深度/阴影 pass 通过 positionVAO 绘制
+Mesh uploadMesh(const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices,
+    VertexFormat format = VertexFormat::Float32, bool positionStream = false);
+// 指针版本：可直接从内存映射的缓存文件上传
+Mesh uploadMesh(const Vertex* vertices, size_t vertexCount, const unsigned int* indices, size_t indexCount,
+    VertexFormat format = VertexFormat::Float32, bool positionStream = false);
+
+// 绑定深度 pass 使用的 VAO：有位置流时使用 positionVAO，否则退回完整属性 VAO
+void bindDepthVertexArray(const Mesh& mesh);
+
+// 顶点格式压缩
+CompactVertex packVertex(const Vertex& vertex, const glm::vec3& boundsMin, const glm::vec3& boundsExtent);
+glm::vec2 encodeOctahedral(const glm::vec3& normal);
+
+#endif // MESH_H
@@ -0,0 +1,359 @@
+#include "MeshOptimizer.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <cstdint>
+
+namespace {
+
+// 简单 FIFO 缓存模拟器：时间戳法，命中判断为 O(1)
+struct FifoCache {
+    std::vector<unsigned int> stamps;
+    unsigned int time;
+    unsigned int size;
+
+    FifoCache(size_t vertexCount, unsigned int cacheSize)
+        : stamps(vertexCount, 0), time(cacheSize + 1), size(cacheSize) {}
+
+    // 返回是否未命中
+    bool touch(unsigned int v) {
+        if (time - stamps[v] > size) {
+            stamps[v] = time++;
+            return true;
+        }
+        return false;
+    }
+
+    void reset() {
+        // 把时间推进到所有已缓存顶点都过期
+        time += size + 1;
+    }
+};
+
+// 顶点 -> 三角形 邻接表（CSR 形式）
+struct TriangleAdjacency {
+    std::vector<unsigned int> counts;
+    std::vector<unsigned int> offsets;
+    std::vector<unsigned int> data;
+
+    void build(const std::vector<unsigned int>& indices, size_t vertexCount) {
+        size_t faceCount = indices.size() / 3;
+        counts.assign(vertexCount, 0);
+        offsets.assign(vertexCount, 0);
+        data.resize(indices.size());
+
+        for (unsigned int idx : indices) counts[idx]++;
+
+        unsigned int offset = 0;
+        for (size_t v = 0; v < vertexCount; v++) {
+            offsets[v] = offset;
+            offset += counts[v];
+        }
+
+        std::vector<unsigned int> fill(offsets);
+        for (size_t f = 0; f < faceCount; f++) {
+            for (int k = 0; k < 3; k++) {
+                unsigned int v = indices[f * 3 + k];
+                data[fill[v]++] = (unsigned int)f;
+            }
+        }
+    }
+};
+
+int skipDeadEnd(const std::vector<unsigned int>& liveCount, std::vector<unsigned int>& deadEnd,
+    size_t& cursor, size_t vertexCount) {
+    while (!deadEnd.empty()) {
+        unsigned int v = deadEnd.back();
+        deadEnd.pop_back();
+        if (liveCount[v] > 0) return (int)v;
+    }
+    while (cursor < vertexCount) {
+        if (liveCount[cursor] > 0) return (int)cursor++;
+        cursor++;
+    }
+    return -1;
+}
+
+uint32_t hashBytes(const unsigned char* data, size_t size) {
+    // FNV-1a
+    uint32_t h = 2166136261u;
+    for (size_t i = 0; i < size; i++) {
+        h ^= data[i];
+        h *= 16777619u;
+    }
+    return h;
+}
+
+} // namespace
+
+std::vector<unsigned int> generateVertexRemap(const void* vertices, size_t vertexCount,
+    size_t vertexSize, size_t& uniqueCount) {
+    std::vector<unsigned int> remap(vertexCount, ~0u);
+    uniqueCount = 0;
+    if (vertexCount == 0) return remap;
+
+    const unsigned char* bytes = static_cast<const unsigned char*>(vertices);
+
+    // 开放寻址哈希表，容量为 2 的幂且至少是顶点数的 2 倍
+    size_t capacity = 1;
+    while (capacity < vertexCount * 2) capacity *= 2;
+    std::vector<unsigned int> table(capacity, ~0u);
+
+    for (size_t i = 0; i < vertexCount; i++) {
+        const unsigned char* vertex = bytes + i * vertexSize;
+        size_t slot = hashBytes(vertex, vertexSize) & (capacity - 1);
+
+        while (true) {
+            unsigned int entry = table[slot];
+            if (entry == ~0u) {
+                table[slot] = (unsigned int)i;
+                remap[i] = (unsigned int)uniqueCount++;
+                break;
+            }
+            if (std::memcmp(bytes + entry * vertexSize, vertex, vertexSize) == 0) {
+                remap[i] = remap[entry];
+                break;
+            }
+            slot = (slot + 1) & (capacity - 1);
+        }
+    }
+    return remap;
+}
+
+void remapIndexBuffer(std::vector<unsigned int>& indices, const std::vector<unsigned int>& remap) {
+    for (unsigned int& idx : indices) {
+        idx = remap[idx];
+    }
+}
+
+VertexCacheStats analyzeVertexCache(const std::vector<unsigned int>& indices,
+    size_t vertexCount, unsigned int cacheSize) {
+    VertexCacheStats stats = { 0.0f, 0.0f };
+    if (indices.empty() || vertexCount == 0) return stats;
+
+    FifoCache cache(vertexCount, cacheSize);
+    std::vector<char> referenced(vertexCount, 0);
+    size_t misses = 0;
+    size_t uniqueVertices = 0;
+
+    for (unsigned int idx : indices) {
+        if (cache.touch(idx)) misses++;
+        if (!referenced[idx]) {
+            referenced[idx] = 1;
+            uniqueVertices++;
+        }
+    }
+
+    stats.acmr = (float)misses / (float)(indices.size() / 3);
+    stats.atvr = uniqueVertices > 0 ? (float)misses / (float)uniqueVertices : 0.0f;
+    return stats;
+}
+
+void optimizeVertexCache(std::vector<unsigned int>& indices, size_t vertexCount,
+    unsigned int cacheSize, std::vector<unsigned int>* clusters) {
+    size_t faceCount = indices.size() / 3;
+    if (clusters) clusters->clear();
+    if (faceCount == 0 || vertexCount == 0) return;
+
+    TriangleAdjacency adjacency;
+    adjacency.build(indices, vertexCount);
+
+    std::vector<unsigned int> liveCount(adjacency.counts);
+    std::vector<unsigned int> cacheTime(vertexCount, 0);
+    std::vector<char> emitted(faceCount, 0);
+    std::vector<unsigned int> deadEnd;
+    std::vector<unsigned int> candidates;
+    std::vector<unsigned int> result;
+    result.reserve(indices.size());
+
+    unsigned int timestamp = cacheSize + 1;
+    size_t cursor = 1;
+    int fanning = 0;
+
+    if (clusters) clusters->push_back(0);
+
+    while (fanning >= 0) {
+        candidates.clear();
+
+        // 输出 fanning 顶点所有尚未输出的三角形
+        unsigned int begin = adjacency.offsets[fanning];
+        unsigned int end = begin + adjacency.counts[fanning];
+        for (unsigned int i = begin; i < end; i++) {
+            unsigned int face = adjacency.data[i];
+            if (emitted[face]) continue;
+
+            for (int k = 0; k < 3; k++) {
+                unsigned int v = indices[face * 3 + k];
+                result.push_back(v);
+                deadEnd.push_back(v);
+                candidates.push_back(v);
+                liveCount[v]--;
+                if (timestamp - cacheTime[v] > cacheSize) {
+                    cacheTime[v] = timestamp++;
+                }
+            }
+            emitted[face] = 1;
+        }
+
+        // 在候选顶点中选择下一个 fanning 顶点
+        int next = -1;
+        int bestPriority = -1;
+        for (unsigned int v : candidates) {
+            if (liveCount[v] == 0) continue;
+            int priority = 0;
+            if (timestamp - cacheTime[v] + 2 * liveCount[v] <= cacheSize) {
+                priority = (int)(timestamp - cacheTime[v]);
+            }
+            if (priority > bestPriority) {
+                bestPriority = priority;
+                next = (int)v;
+            }
+        }
+
+        if (next == -1) {
+            next = skipDeadEnd(liveCount, deadEnd, cursor, vertexCount);
+            // 跳转到不相邻区域，形成一个硬簇边界
+            if (next >= 0 && clusters && clusters->back() != result.size() / 3) {
+                clusters->push_back((unsigned int)(result.size() / 3));
+            }
+        }
+        fanning = next;
+    }
+
+    indices.swap(result);
+}
+
+void optimizeOverdraw(std::vector<unsigned int>& indices, const std::vector<unsigned int>& clusters,
+    const float* positions, size_t vertexCount, size_t positionStride,
+    unsigned int cacheSize, float threshold) {
+    size_t faceCount = indices.size() / 3;
+    if (faceCount == 0 || clusters.empty()) return;
+
+    // 1. 在硬边界内寻找软边界：从空缓存开始绘制到此处的 ACMR 不超过阈值即可切分
+    std::vector<unsigned int> softClusters;
+    FifoCache cache(vertexCount, cacheSize);
+    for (size_t c = 0; c < clusters.size(); c++) {
+        size_t start = clusters[c];
+        size_t end = (c + 1 < clusters.size()) ? clusters[c + 1] : faceCount;
+
+        cache.reset();
+        size_t clusterMisses = 0;
+        for (size_t f = start; f < end; f++) {
+            for (int k = 0; k < 3; k++) {
+                if (cache.touch(indices[f * 3 + k])) clusterMisses++;
+            }
+        }
+        float targetAcmr = (float)clusterMisses / (float)(end - start) * threshold;
+
+        softClusters.push_back((unsigned int)start);
+        cache.reset();
+        size_t misses = 0;
+        size_t last = start;
+        for (size_t f = start; f < end; f++) {
+            for (int k = 0; k < 3; k++) {
+                if (cache.touch(indices[f * 3 + k])) misses++;
+            }
+            if (f + 1 < end && (float)misses / (float)(f + 1 - last) <= targetAcmr) {
+                softClusters.push_back((unsigned int)(f + 1));
+                cache.reset();
+                misses = 0;
+                last = f + 1;
+            }
+        }
+    }
+
+    // 2. 计算网格质心与每个簇的（面积加权）质心与法线
+    auto position = [&](unsigned int v, int axis) {
+        return positions[v * positionStride + axis];
+    };
+
+    float meshCentroid[3] = { 0.0f, 0.0f, 0.0f };
+    float meshArea = 0.0f;
+    std::vector<float> clusterCentroids(softClusters.size() * 3, 0.0f);
+    std::vector<float> clusterNormals(softClusters.size() * 3, 0.0f);
+
+    for (size_t c = 0; c < softClusters.size(); c++) {
+        size_t start = softClusters[c];
+        size_t end = (c + 1 < softClusters.size()) ? softClusters[c + 1] : faceCount;
+        float clusterArea = 0.0f;
+
+        for (size_t f = start; f < end; f++) {
+            unsigned int a = indices[f * 3 + 0];
+            unsigned int b = indices[f * 3 + 1];
+            unsigned int d = indices[f * 3 + 2];
+
+            float e1[3], e2[3], n[3], center[3];
+            for (int k = 0; k < 3; k++) {
+                e1[k] = position(b, k) - position(a, k);
+                e2[k] = position(d, k) - position(a, k);
+                center[k] = (position(a, k) + position(b, k) + position(d, k)) / 3.0f;
+            }
+            n[0] = e1[1] * e2[2] - e1[2] * e2[1];
+            n[1] = e1[2] * e2[0] - e1[0] * e2[2];
+            n[2] = e1[0] * e2[1] - e1[1] * e2[0];
+            float area = std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+
+            for (int k = 0; k < 3; k++) {
+                clusterCentroids[c * 3 + k] += center[k] * area;
+                clusterNormals[c * 3 + k] += n[k];
+                meshCentroid[k] += center[k] * area;
+            }
+            clusterArea += area;
+        }
+
+        if (clusterArea > 0.0f) {
+            for (int k = 0; k < 3; k++) clusterCentroids[c * 3 + k] /= clusterArea;
+        }
+        meshArea += clusterArea;
+    }
+
+    if (meshArea > 0.0f) {
+        for (int k = 0; k < 3; k++) meshCentroid[k] /= meshArea;
+    }
+
+    // 3. 按 dot(簇质心 - 网格质心, 簇法线) 从大到小排序：朝外的簇优先绘制
+    std::vector<float> sortKeys(softClusters.size());
+    for (size_t c = 0; c < softClusters.size(); c++) {
+        float length = std::sqrt(clusterNormals[c * 3] * clusterNormals[c * 3] +
+            clusterNormals[c * 3 + 1] * clusterNormals[c * 3 + 1] +
+            clusterNormals[c * 3 + 2] * clusterNormals[c * 3 + 2]);
+        float key = 0.0f;
+        if (length > 0.0f) {
+            for (int k = 0; k < 3; k++) {
+                key += (clusterCentroids[c * 3 + k] - meshCentroid[k]) * clusterNormals[c * 3 + k] / length;
+            }
+        }
+        sortKeys[c] = key;
+    }
+
+    std::vector<unsigned int> order(softClusters.size());
+    for (size_t c = 0; c < order.size(); c++) order[c] = (unsigned int)c;
+    std::stable_sort(order.begin(), order.end(), [&](unsigned int a, unsigned int b) {
+        return sortKeys[a] > sortKeys[b];
+    });
+
+    std::vector<unsigned int> result;
+    result.reserve(indices.size());
+    for (unsigned int c : order) {
+        size_t start = softClusters[c];
+        size_t end = (c + 1 < softClusters.size()) ? softClusters[c + 1] : faceCount;
+        result.insert(result.end(), indices.begin() + start * 3, indices.begin() + end * 3);
+    }
+    indices.swap(result);
+}
+
+std::vector<unsigned int> optimizeVertexFetch(std::vector<unsigned int>& indices,
+    size_t vertexCount, size_t& newVertexCount) {
+    std::vector<unsigned int> remap(vertexCount, ~0u);
+    unsigned int next = 0;
+
+    for (unsigned int& idx : indices) {
+        if (remap[idx] == ~0u) {
+            remap[idx] = next++;
+        }
+        idx = remap[idx];
+    }
+
+    newVertexCount = next;
+    return remap;
+}
@@ -0,0 +1,53 @@
+#ifndef MESH_OPTIMIZER_H
+#define MESH_OPTIMIZER_H
+
+#include <vector>
+#include <cstddef>
+
+// 顶点缓存统计（FIFO 缓存模拟）
+struct VertexCacheStats {
+    float acmr; // 平均每个三角形的缓存未命中次数
+    float atvr; // 平均每个顶点的变换次数（1.0 为最优）
+};
+
+// 顶点焊接：按顶点字节内容哈希，合并完全相同的顶点
+// 返回 旧下标 -> 新下标 的映射，uniqueCount 输出去重后的顶点数
+std::vector<unsigned int> generateVertexRemap(const void* vertices, size_t vertexCount,
+    size_t vertexSize, size_t& uniqueCount);
+
+// 按映射改写索引
+void remapIndexBuffer(std::vector<unsigned int>& indices, const std::vector<unsigned int>& remap);
+
+// 模拟后变换顶点缓存，统计 ACMR / ATVR
+VertexCacheStats analyzeVertexCache(const std::vector<unsigned int>& indices,
+    size_t vertexCount, unsigned int cacheSize = 16);
+
+// Tipsify 顶点缓存优化（Sander et al. 2007），原地重排三角形顺序
+// clusters 不为空时输出硬边界（每个簇起始三角形下标），供 overdraw 优化使用
+void optimizeVertexCache(std::vector<unsigned int>& indices, size_t vertexCount,
+    unsigned int cacheSize = 16, std::vector<unsigned int>* clusters = nullptr);
+
+// overdraw 优化：在不让 ACMR 超过 threshold 倍的前提下细分簇，
+// 再按簇朝外程度排序，使外侧三角形先绘制以提前深度剔除
+void optimizeOverdraw(std::vector<unsigned int>& indices, const std::vector<unsigned int>& clusters,
+    const float* positions, size_t vertexCount, size_t positionStride,
+    unsigned int cacheSize = 16, float threshold = 1.05f);
+
+// 顶点读取优化：按首次引用顺序重新编号顶点，原地改写 indices
+// 返回 旧下标 -> 新下标 的映射（未被引用的顶点为 ~0u），newVertexCount 输出新的顶点数
+std::vector<unsigned int> optimizeVertexFetch(std::vector<unsigned int>& indices,
+    size_t vertexCount, size_t& newVertexCount);
+
+// 按 remap 重排顶点数组（丢弃未引用顶点）
+template <typename T>
+void remapVertexBuffer(std::vector<T>& vertices, const std::vector<unsigned int>& remap, size_t newVertexCount) {
+    std::vector<T> result(newVertexCount);
+    for (size_t i = 0; i < vertices.size(); i++) {
+        if (remap[i] != ~0u) {
+            result[remap[i]] = vertices[i];
+        }
+    }
+    vertices.swap(result);
+}
+
+#endif // MESH_OPTIMIZER_H
@@ -0,0 +1,159 @@
+#include "Meshlet.h"
+#include "Mesh.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+void finishMeshlet(Meshlet& meshlet, const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices) {
+    size_t begin = meshlet.indexOffset;
+    size_t end = begin + meshlet.indexCount;
+
+    // 包围球：AABB 中心 + 最远顶点距离
+    glm::vec3 boundsMin(vertices[indices[begin]].Position);
+    glm::vec3 boundsMax(boundsMin);
+    for (size_t i = begin; i < end; i++) {
+        boundsMin = glm::min(boundsMin, vertices[indices[i]].Position);
+        boundsMax = glm::max(boundsMax, vertices[indices[i]].Position);
+    }
+    meshlet.center = (boundsMin + boundsMax) * 0.5f;
+    float radius = 0.0f;
+    for (size_t i = begin; i < end; i++) {
+        radius = std::max(radius, glm::length(vertices[indices[i]].Position - meshlet.center));
+    }
+    meshlet.radius = radius;
+
+    // 法线锥：轴为三角形法线的平均方向，半角由最偏离轴的法线决定
+    std::vector<glm::vec3> normals;  // 退化三角形记为零向量
+    normals.reserve(meshlet.indexCount / 3);
+    glm::vec3 axis(0.0f);
+    for (size_t i = begin; i < end; i += 3) {
+        const glm::vec3& p0 = vertices[indices[i]].Position;
+        const glm::vec3& p1 = vertices[indices[i + 1]].Position;
+        const glm::vec3& p2 = vertices[indices[i + 2]].Position;
+        glm::vec3 n = glm::cross(p1 - p0, p2 - p0);
+        float length = glm::length(n);
+        normals.push_back(length > 0.0f ? n / length : glm::vec3(0.0f));
+        axis += normals.back();
+    }
+
+    meshlet.coneAxis = glm::vec3(0.0f, 1.0f, 0.0f);
+    meshlet.coneApex = meshlet.center;
+    meshlet.coneCutoff = 2.0f;
+
+    float axisLength = glm::length(axis);
+    if (axisLength <= 0.0f) return;
+    axis /= axisLength;
+
+    float minDot = 1.0f;
+    for (const glm::vec3& n : normals) {
+        if (n != glm::vec3(0.0f)) minDot = std::min(minDot, glm::dot(n, axis));
+    }
+    // 法线分布接近或超过半球时无法整体背向
+    if (minDot <= 0.1f) return;
+
+    // apex 沿轴后退到所有三角形平面的正面
+    float maxT = 0.0f;
+    for (size_t t = 0; t < normals.size(); t++) {
+        if (normals[t] == glm::vec3(0.0f)) continue;
+        const glm::vec3& p0 = vertices[indices[begin + t * 3]].Position;
+        float dc = glm::dot(meshlet.center - p0, normals[t]);
+        float dn = glm::dot(axis, normals[t]);
+        maxT = std::max(maxT, dc / dn);
+    }
+
+    meshlet.coneAxis = axis;
+    meshlet.coneApex = meshlet.center - axis * maxT;
+    meshlet.coneCutoff = std::sqrt(1.0f - minDot * minDot);
+}
+
+} // namespace
+
+std::vector<Meshlet> buildMeshlets(const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices,
+    size_t maxVertices, size_t maxTriangles) {
+    std::vector<Meshlet> meshlets;
+    if (indices.empty()) return meshlets;
+
+    // 记录顶点最近一次被哪个 meshlet 引用
+    std::vector<unsigned int> owner(vertices.size(), ~0u);
+
+    Meshlet current = {};
+    current.indexOffset = 0;
+    unsigned int currentId = 0;
+
+    for (size_t i = 0; i < indices.size(); i += 3) {
+        size_t newVertices = 0;
+        for (int k = 0; k < 3; k++) {
+            if (owner[indices[i + k]] != currentId) newVertices++;
+        }
+        // 同一三角形内重复顶点的情况（退化三角形）按上限保守处理
+        if (current.vertexCount + newVertices > maxVertices || current.indexCount / 3 + 1 > maxTriangles) {
+            finishMeshlet(current, vertices, indices);
+            meshlets.push_back(current);
+            current = Meshlet();
+            current.indexOffset = (unsigned int)i;
+            currentId++;
+        }
+
+        for (int k = 0; k < 3; k++) {
+            unsigned int v = indices[i + k];
+            if (owner[v] != currentId) {
+                owner[v] = currentId;
+                current.vertexCount++;
+            }
+        }
+        current.indexCount += 3;
+    }
+
+    if (current.indexCount > 0) {
+        finishMeshlet(current, vertices, indices);
+        meshlets.push_back(current);
+    }
+    return meshlets;
+}
+
+CullingFrustum extractFrustum(const glm::mat4& m) {
+    // Gribb-Hartmann：glm 为列主序，m[col][row]
+    CullingFrustum frustum;
+    glm::vec4 row0(m[0][0], m[1][0], m[2][0], m[3][0]);
+    glm::vec4 row1(m[0][1], m[1][1], m[2][1], m[3][1]);
+    glm::vec4 row2(m[0][2], m[1][2], m[2][2], m[3][2]);
+    glm::vec4 row3(m[0][3], m[1][3], m[2][3], m[3][3]);
+
+    frustum.planes[0] = row3 + row0; // 左
+    frustum.planes[1] = row3 - row0; // 右
+    frustum.planes[2] = row3 + row1; // 下
+    frustum.planes[3] = row3 - row1; // 上
+    frustum.planes[4] = row3 + row2; // 近
+    frustum.planes[5] = row3 - row2; // 远
+
+    for (glm::vec4& plane : frustum.planes) {
+        float length = glm::length(glm::vec3(plane));
+        if (length > 0.0f) plane /= length;
+    }
+    return frustum;
+}
+
+bool isSphereInFrustum(const glm::vec3& center, float radius, const CullingFrustum& frustum) {
+    for (const glm::vec4& plane : frustum.planes) {
+        if (glm::dot(glm::vec3(plane), center) + plane.w < -radius) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool isMeshletVisible(const Meshlet& meshlet, const CullingFrustum& frustum, const glm::vec3& cameraPos) {
+    if (!isSphereInFrustum(meshlet.center, meshlet.radius, frustum)) {
+        return false;
+    }
+
+    if (meshlet.coneCutoff <= 1.0f) {
+        glm::vec3 toApex = meshlet.coneApex - cameraPos;
+        float distance = glm::length(toApex);
+        if (distance > 0.0f && glm::dot(toApex / distance, meshlet.coneAxis) >= meshlet.coneCutoff) {
+            return false;
+        }
+    }
+    return true;
+}
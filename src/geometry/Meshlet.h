@@ -0,0 +1,39 @@
+#ifndef MESHLET_H
+#define MESHLET_H
+
+#include <glm/glm.hpp>
+#include <vector>
+#include <cstddef>
+
+struct Vertex;
+
+// meshlet：索引缓冲中一段连续的三角形，附带包围球与法线锥
+struct Meshlet {
+    unsigned int indexOffset; // 起始索引（以索引个数计）
+    unsigned int indexCount;
+    unsigned int vertexCount; // 引用的不同顶点数
+    glm::vec3 center;         // 包围球（模型空间）
+    float radius;
+    glm::vec3 coneApex;       // 法线锥：从 apex 看向簇的方向与 axis 夹角足够小时整簇背向相机
+    glm::vec3 coneAxis;
+    float coneCutoff;         // > 1 表示法线分布过散，不做背面剔除
+};
+
+// 模型空间视锥平面（由 proj * view * model 提取，已归一化）
+struct CullingFrustum {
+    glm::vec4 planes[6];
+};
+
+// 按索引顺序贪心划分 meshlet（不改变三角形顺序，保留顶点缓存优化结果）
+std::vector<Meshlet> buildMeshlets(const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices,
+    size_t maxVertices = 64, size_t maxTriangles = 124);
+
+CullingFrustum extractFrustum(const glm::mat4& clipFromModel);
+
+// 包围球与视锥是否相交（同一坐标空间）
+bool isSphereInFrustum(const glm::vec3& center, float radius, const CullingFrustum& frustum);
+
+// 视锥剔除 + 法线锥背面剔除；cameraPos 为模型空间相机位置
+bool isMeshletVisible(const Meshlet& meshlet, const CullingFrustum& frustum, const glm::vec3& cameraPos);
+
+#endif // MESHLET_H
@@ -9,6 +9,25 @@
 #define M_PI 3.14159265358979323846
 #endif
 
+// 是否为基础几何体额外创建仅位置流（深度 pass 使用）
+static bool primitivePositionStreams = false;
+
+void setPrimitivePositionStreams(bool enabled) {
+    primitivePositionStreams = enabled;
+}
+
+// 将 8-float 交错数组（位置(3), 法线(3), 纹理坐标(2)）转换为 Vertex 数组
+static std::vector<Vertex> toVertices(const float* data, size_t floatCount) {
+    std::vector<Vertex> vertices(floatCount / 8);
+    for (size_t i = 0; i < vertices.size(); i++) {
+        const float* f = data + i * 8;
+        vertices[i].Position = glm::vec3(f[0], f[1], f[2]);
+        vertices[i].Normal = glm::vec3(f[3], f[4], f[5]);
+        vertices[i].TexCoords = glm::vec2(f[6], f[7]);
+    }
+    return vertices;
+}
+
 Mesh createCube() {
     float v[] = {
         // 位置              // 法线              // 纹理坐标
@@ -58,36 +77,16 @@ Mesh createCube() {
         20,21,22, 22,23,20
     };
 
-    Mesh m;
-    glGenVertexArrays(1, &m.VAO);
-    glGenBuffers(1, &m.VBO);
-    glGenBuffers(1, &m.EBO);
-
-    glBindVertexArray(m.VAO);
-    glBindBuffer(GL_ARRAY_BUFFER, m.VBO);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(v), v, GL_STATIC_DRAW);
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m.EBO);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(indices), indices, GL_STATIC_DRAW);
-
-    glEnableVertexAttribArray(0);
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)0); // Pos
-    glEnableVertexAttribArray(1);
-    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)(3 * sizeof(float))); // Normal
-    glEnableVertexAttribArray(2); // 纹理坐标
-    glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)(6 * sizeof(float))); // TexCoord
-
-    glBindVertexArray(0);
-    m.indexCount = sizeof(indices) / sizeof(indices[0]);
-    return m;
+    return uploadMesh(toVertices(v, sizeof(v) / sizeof(float)),
+        std::vector<unsigned int>(indices, indices + sizeof(indices) / sizeof(indices[0])),
+        VertexFormat::Float32, primitivePositionStreams);
 }
 
 Mesh createCone(int segments, float height, float radius) {
-    Mesh m;
     std::vector<float> verts;
     std::vector<unsigned int> indices;
 
     // 每顶点 8 个浮点数：Position(3) + Normal(3) + UV(2)
-    const int stride = 8;
     int vertexCount = 0;
 
     // 1. 顶部顶点 (Tip)
@@ -127,35 +126,7 @@ Mesh createCone(int segments, float height, float radius) {
         indices.push_back(i + 2);
     }
 
-    m.indexCount = indices.size();
-
-    // -------------------- VAO 配置 --------------------
-    glGenVertexArrays(1, &m.VAO);
-    glGenBuffers(1, &m.VBO);
-    glGenBuffers(1, &m.EBO);
-
-    glBindVertexArray(m.VAO);
-
-    glBindBuffer(GL_ARRAY_BUFFER, m.VBO);
-    glBufferData(GL_ARRAY_BUFFER, verts.size() * sizeof(float), verts.data(), GL_STATIC_DRAW);
-
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m.EBO);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(unsigned int), indices.data(), GL_STATIC_DRAW);
-
-    // Position (3 floats)
-    glEnableVertexAttribArray(0);
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, stride * sizeof(float), (void*)0);
-
-    // Normal (3 floats)
-    glEnableVertexAttribArray(1);
-    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, stride * sizeof(float), (void*)(3 * sizeof(float)));
-
-    // TexCoord (2 floats) 
-    glEnableVertexAttribArray(2);
-    glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, stride * sizeof(float), (void*)(6 * sizeof(float)));
-
-    glBindVertexArray(0);
-    return m;
+    return uploadMesh(toVertices(verts.data(), verts.size()), indices, VertexFormat::Float32, primitivePositionStreams);
 }
 
 Mesh createCylinder(int segments, float height, float radius) {
@@ -192,27 +163,7 @@ Mesh createCylinder(int segments, float height, float radius) {
         inds.push_back(b2); inds.push_back(a2); inds.push_back(a);
     }
 
-    Mesh m;
-    glGenVertexArrays(1, &m.VAO);
-    glGenBuffers(1, &m.VBO);
-    glGenBuffers(1, &m.EBO);
-
-    glBindVertexArray(m.VAO);
-    glBindBuffer(GL_ARRAY_BUFFER, m.VBO);
-    glBufferData(GL_ARRAY_BUFFER, verts.size() * sizeof(float), verts.data(), GL_STATIC_DRAW);
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m.EBO);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, inds.size() * sizeof(unsigned int), inds.data(), GL_STATIC_DRAW);
-
-    glEnableVertexAttribArray(0);
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)0); // Pos
-    glEnableVertexAttribArray(1);
-    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)(3 * sizeof(float))); // Normal
-    glEnableVertexAttribArray(2); 
-    glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)(6 * sizeof(float))); // TexCoord
-
-    glBindVertexArray(0);
-    m.indexCount = (GLsizei)inds.size();
-    return m;
+    return uploadMesh(toVertices(verts.data(), verts.size()), inds, VertexFormat::Float32, primitivePositionStreams);
 }
 
 Mesh createWindow(float width, float height) {
@@ -239,32 +190,9 @@ Mesh createWindow(float width, float height) {
         4,5,6, 6,7,4
     };
 
-    Mesh m;
-    glGenVertexArrays(1, &m.VAO);
-    glGenBuffers(1, &m.VBO);
-    glGenBuffers(1, &m.EBO);
-
-    glBindVertexArray(m.VAO);
-    glBindBuffer(GL_ARRAY_BUFFER, m.VBO);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m.EBO);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(indices), indices, GL_STATIC_DRAW);
-
-    // Position
-    glEnableVertexAttribArray(0);
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)0);
-
-    // Normal
-    glEnableVertexAttribArray(1);
-    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)(3 * sizeof(float)));
-
-    // TexCoord（新增）
-    glEnableVertexAttribArray(2);
-    glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)(6 * sizeof(float)));
-
-    glBindVertexArray(0);
-    m.indexCount = 12;
-    return m;
+    return uploadMesh(toVertices(vertices, sizeof(vertices) / sizeof(float)),
+        std::vector<unsigned int>(indices, indices + sizeof(indices) / sizeof(indices[0])),
+        VertexFormat::Float32, primitivePositionStreams);
 }
 
 Mesh createDoor(float width, float height) {
@@ -291,32 +219,9 @@ Mesh createDoor(float width, float height) {
         4, 5, 6,  6, 7, 4     // 内层门板
     };
 
-    Mesh m;
-    glGenVertexArrays(1, &m.VAO);
-    glGenBuffers(1, &m.VBO);
-    glGenBuffers(1, &m.EBO);
-
-    glBindVertexArray(m.VAO);
-    glBindBuffer(GL_ARRAY_BUFFER, m.VBO);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m.EBO);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(indices), indices, GL_STATIC_DRAW);
-
-    // Position
-    glEnableVertexAttribArray(0);
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)0);
-
-    // Normal
-    glEnableVertexAttribArray(1);
-    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)(3 * sizeof(float)));
-
-    // TexCoord
-    glEnableVertexAttribArray(2);
-    glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)(6 * sizeof(float)));
-
-    glBindVertexArray(0);
-    m.indexCount = sizeof(indices) / sizeof(indices[0]);
-    return m;
+    return uploadMesh(toVertices(vertices, sizeof(vertices) / sizeof(float)),
+        std::vector<unsigned int>(indices, indices + sizeof(indices) / sizeof(indices[0])),
+        VertexFormat::Float32, primitivePositionStreams);
 }
 
 Mesh createRoof(float width, float depth, float pitch) {
@@ -378,35 +283,7 @@ Mesh createRoof(float width, float depth, float pitch) {
         14, 15, 12   // 底面三角形2
     };
 
-    Mesh m;
-    glGenVertexArrays(1, &m.VAO);
-    glGenBuffers(1, &m.VBO);
-    glGenBuffers(1, &m.EBO);
-
-    glBindVertexArray(m.VAO);
-
-    // 顶点数据
-    glBindBuffer(GL_ARRAY_BUFFER, m.VBO);
-    glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(float), vertices.data(), GL_STATIC_DRAW);
-
-    // 索引数据
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m.EBO);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(unsigned int), indices.data(), GL_STATIC_DRAW);
-
-    // 顶点属性指针 (Stride = 8 * sizeof(float))
-    // 位置属性
-    glEnableVertexAttribArray(0);
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)0);
-    // 法线属性
-    glEnableVertexAttribArray(1);
-    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)(3 * sizeof(float)));
-    // 纹理坐标属性
-    glEnableVertexAttribArray(2);
-    glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)(6 * sizeof(float)));
-
-    glBindVertexArray(0);
-    m.indexCount = indices.size();
-    return m;
+    return uploadMesh(toVertices(vertices.data(), vertices.size()), indices, VertexFormat::Float32, primitivePositionStreams);
 }
 
 Mesh createSkybox() {
@@ -467,4 +344,3 @@ Mesh createSkybox() {
     m.indexCount = 36;
     return m;
 }
-
@@ -3,6 +3,9 @@
 
 #include "Mesh.h"
 
+// 之后创建的几何体（天空盒除外）是否附带仅位置流，默认关闭
+void setPrimitivePositionStreams(bool enabled);
+
 Mesh createCube();
 Mesh createCone(int segments = 20, float height = 1.0f, float radius = 0.8f);
 Mesh createCylinder(int segments = 16, float height = 1.0f, float radius = 0.2f);
@@ -0,0 +1,395 @@
+#include "VoxelMesher.h"
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <set>
+#include <tuple>
+#include <cstdint>
+
+namespace {
+
+// 网格对齐的单位方块面
+struct GridQuad {
+    int axis;           // 法线所在轴 0/1/2
+    int dir;            // 法线方向 +1 / -1
+    long plane;         // 沿法线轴的格点坐标
+    long a, b;          // 平面内两个轴上的格点坐标（单元左下角）
+    glm::vec2 uv00;     // 单元 (a, b) 角的 UV
+    glm::vec2 uvA;      // 沿平面第一轴前进一格的 UV 增量
+    glm::vec2 uvB;      // 沿平面第二轴前进一格的 UV 增量
+    bool removed;
+};
+
+// 由两个三角形组成的轴对齐正方形
+struct QuadCandidate {
+    unsigned int triangle;  // 第一个三角形下标（第二个为 triangle + 1）
+    int axis;
+    int dir;
+    float side;
+    glm::vec3 minCorner;
+    glm::vec2 uv00, uv10, uv01;
+};
+
+const float kUvEpsilon = 1e-5f;
+
+long quantizeUv(float v) {
+    return std::lround(v * 1048576.0f);
+}
+
+bool nearlyEqual(const glm::vec2& x, const glm::vec2& y) {
+    return std::abs(x.x - y.x) < kUvEpsilon && std::abs(x.y - y.y) < kUvEpsilon;
+}
+
+// 检查三角形 t, t+1 是否组成轴对齐正方形，并提取其 UV 映射
+bool detectQuad(const MeshData& mesh, unsigned int t, QuadCandidate& quad) {
+    const Vertex* corners[6];
+    for (int k = 0; k < 6; k++) {
+        corners[k] = &mesh.vertices[mesh.indices[t * 3 + k]];
+    }
+
+    // 去重得到四个角
+    const Vertex* unique[4];
+    int uniqueCount = 0;
+    for (int k = 0; k < 6; k++) {
+        bool found = false;
+        for (int u = 0; u < uniqueCount; u++) {
+            if (unique[u]->Position == corners[k]->Position) {
+                if (!nearlyEqual(unique[u]->TexCoords, corners[k]->TexCoords)) return false;
+                found = true;
+                break;
+            }
+        }
+        if (!found) {
+            if (uniqueCount == 4) return false;
+            unique[uniqueCount++] = corners[k];
+        }
+    }
+    if (uniqueCount != 4) return false;
+
+    // 法线轴：四个角在该轴上坐标相同
+    int axis = -1;
+    for (int k = 0; k < 3; k++) {
+        if (unique[0]->Position[k] == unique[1]->Position[k] &&
+            unique[0]->Position[k] == unique[2]->Position[k] &&
+            unique[0]->Position[k] == unique[3]->Position[k]) {
+            if (axis != -1) return false;
+            axis = k;
+        }
+    }
+    if (axis == -1) return false;
+
+    int uAxis = (axis + 1) % 3;
+    int vAxis = (axis + 2) % 3;
+
+    glm::vec3 minCorner(unique[0]->Position);
+    glm::vec3 maxCorner(unique[0]->Position);
+    for (int u = 1; u < 4; u++) {
+        minCorner = glm::min(minCorner, unique[u]->Position);
+        maxCorner = glm::max(maxCorner, unique[u]->Position);
+    }
+    float sideU = maxCorner[uAxis] - minCorner[uAxis];
+    float sideV = maxCorner[vAxis] - minCorner[vAxis];
+    if (sideU <= 0.0f || std::abs(sideU - sideV) > sideU * 1e-4f) return false;
+
+    // 每个角必须恰好位于正方形的一个顶点上
+    const Vertex* grid[2][2] = { { nullptr, nullptr }, { nullptr, nullptr } };
+    for (int u = 0; u < 4; u++) {
+        const glm::vec3& p = unique[u]->Position;
+        int i, j;
+        if (p[uAxis] == minCorner[uAxis]) i = 0; else if (p[uAxis] == maxCorner[uAxis]) i = 1; else return false;
+        if (p[vAxis] == minCorner[vAxis]) j = 0; else if (p[vAxis] == maxCorner[vAxis]) j = 1; else return false;
+        if (grid[i][j]) return false;
+        grid[i][j] = unique[u];
+    }
+
+    // 两个三角形必须覆盖整个正方形（面积之和等于正方形面积且朝向一致）
+    glm::vec3 n0 = glm::cross(corners[1]->Position - corners[0]->Position, corners[2]->Position - corners[0]->Position);
+    glm::vec3 n1 = glm::cross(corners[4]->Position - corners[3]->Position, corners[5]->Position - corners[3]->Position);
+    float area = std::abs(n0[axis]) + std::abs(n1[axis]);
+    if (n0[axis] * n1[axis] <= 0.0f || std::abs(area - 2.0f * sideU * sideU) > sideU * sideU * 1e-3f) return false;
+
+    int dir = n0[axis] > 0.0f ? 1 : -1;
+
+    // 顶点法线需要与面法线一致（平滑法线的网格不参与合并）
+    glm::vec3 faceNormal(0.0f);
+    faceNormal[axis] = (float)dir;
+    for (int u = 0; u < 4; u++) {
+        if (glm::dot(glm::normalize(unique[u]->Normal), faceNormal) < 0.999f) return false;
+    }
+
+    // UV 必须是格点坐标的仿射函数
+    glm::vec2 uv00 = grid[0][0]->TexCoords;
+    glm::vec2 uv10 = grid[1][0]->TexCoords;
+    glm::vec2 uv01 = grid[0][1]->TexCoords;
+    glm::vec2 uv11 = grid[1][1]->TexCoords;
+    if (!nearlyEqual(uv11, uv10 + uv01 - uv00)) return false;
+
+    quad.triangle = t;
+    quad.axis = axis;
+    quad.dir = dir;
+    quad.side = sideU;
+    quad.minCorner = minCorner;
+    quad.uv00 = uv00;
+    quad.uv10 = uv10;
+    quad.uv01 = uv01;
+    return true;
+}
+
+// 取出现次数最多的边长作为方块尺寸
+float detectCellSize(const std::vector<QuadCandidate>& candidates) {
+    std::map<long, std::pair<size_t, float>> histogram;
+    for (const QuadCandidate& q : candidates) {
+        long key = std::lround(std::log2(q.side) * 4096.0f);
+        auto& entry = histogram[key];
+        entry.first++;
+        entry.second = q.side;
+    }
+    size_t best = 0;
+    float cell = 0.0f;
+    for (const auto& entry : histogram) {
+        if (entry.second.first > best) {
+            best = entry.second.first;
+            cell = entry.second.second;
+        }
+    }
+    return cell;
+}
+
+bool toGrid(float value, float origin, float cell, long& result) {
+    float t = (value - origin) / cell;
+    float r = std::round(t);
+    if (std::abs(t - r) > 1e-3f) return false;
+    result = (long)r;
+    return true;
+}
+
+void emitQuad(MeshData& part, const GridQuad& q, long a0, long b0, long a1, long b1,
+    const glm::vec3& origin, float cell) {
+    int uAxis = (q.axis + 1) % 3;
+    int vAxis = (q.axis + 2) % 3;
+
+    auto corner = [&](long a, long b) {
+        Vertex v;
+        v.Position[q.axis] = origin[q.axis] + cell * (float)q.plane;
+        v.Position[uAxis] = origin[uAxis] + cell * (float)a;
+        v.Position[vAxis] = origin[vAxis] + cell * (float)b;
+        v.Normal = glm::vec3(0.0f);
+        v.Normal[q.axis] = (float)q.dir;
+        // 超出单个图块的部分由片段着色器在图块内重复
+        v.TexCoords = q.uv00 + (float)(a - a0) * q.uvA + (float)(b - b0) * q.uvB;
+        return v;
+    };
+
+    unsigned int base = (unsigned int)part.vertices.size();
+    part.vertices.push_back(corner(a0, b0));
+    part.vertices.push_back(corner(a1, b0));
+    part.vertices.push_back(corner(a1, b1));
+    part.vertices.push_back(corner(a0, b1));
+
+    // 保持与原始面相同的绕序
+    glm::vec3 n = glm::cross(part.vertices[base + 1].Position - part.vertices[base].Position,
+                             part.vertices[base + 2].Position - part.vertices[base].Position);
+    if ((n[q.axis] > 0.0f) == (q.dir > 0)) {
+        unsigned int tri[6] = { 0, 1, 2, 0, 2, 3 };
+        for (unsigned int k : tri) part.indices.push_back(base + k);
+    } else {
+        unsigned int tri[6] = { 0, 2, 1, 0, 3, 2 };
+        for (unsigned int k : tri) part.indices.push_back(base + k);
+    }
+}
+
+} // namespace
+
+bool optimizeVoxelMesh(const MeshData& input, bool opaque,
+    std::vector<MeshData>& output, VoxelMeshStats& stats) {
+    size_t triangleCount = input.indices.size() / 3;
+    stats = VoxelMeshStats();
+    stats.trianglesBefore = triangleCount;
+    stats.trianglesAfter = triangleCount;
+    if (triangleCount < 2) return false;
+
+    // 1. 相邻三角形配对，识别轴对齐正方形
+    std::vector<QuadCandidate> candidates;
+    std::vector<char> consumed(triangleCount, 0);
+    for (unsigned int t = 0; t + 1 < triangleCount; t++) {
+        QuadCandidate quad;
+        if (detectQuad(input, t, quad)) {
+            candidates.push_back(quad);
+            t++; // 跳过配对的第二个三角形
+        }
+    }
+
+    // 至少一半三角形属于方块面才视为体素网格
+    if (candidates.size() * 4 < triangleCount) return false;
+
+    float cell = detectCellSize(candidates);
+    if (cell <= 0.0f) return false;
+    stats.cellSize = cell;
+
+    // 2. 转换为格点坐标
+    // 原点取第一个边长为 cell 的方块面（其他尺寸的面不在格点上）
+    auto originQuad = std::find_if(candidates.begin(), candidates.end(),
+        [cell](const QuadCandidate& c) { return std::abs(c.side - cell) <= cell * 1e-3f; });
+    if (originQuad == candidates.end()) return false;
+    glm::vec3 origin = originQuad->minCorner;
+    std::vector<GridQuad> quads;
+    quads.reserve(candidates.size());
+    for (const QuadCandidate& c : candidates) {
+        if (std::abs(c.side - cell) > cell * 1e-3f) continue;
+
+        GridQuad q;
+        q.axis = c.axis;
+        q.dir = c.dir;
+        int uAxis = (c.axis + 1) % 3;
+        int vAxis = (c.axis + 2) % 3;
+        if (!toGrid(c.minCorner[c.axis], origin[c.axis], cell, q.plane) ||
+            !toGrid(c.minCorner[uAxis], origin[uAxis], cell, q.a) ||
+            !toGrid(c.minCorner[vAxis], origin[vAxis], cell, q.b)) {
+            continue;
+        }
+        q.uv00 = c.uv00;
+        q.uvA = c.uv10 - c.uv00;
+        q.uvB = c.uv01 - c.uv00;
+        q.removed = false;
+
+        quads.push_back(q);
+        consumed[c.triangle] = 1;
+        consumed[c.triangle + 1] = 1;
+    }
+    stats.gridQuads = quads.size();
+
+    // 3. 内部面剔除：同一位置上朝向相反的两个面都被相邻实心方块遮挡
+    if (opaque) {
+        std::map<std::tuple<int, long, long, long>, size_t> positiveFaces;
+        for (size_t i = 0; i < quads.size(); i++) {
+            if (quads[i].dir > 0) {
+                positiveFaces[std::make_tuple(quads[i].axis, quads[i].plane, quads[i].a, quads[i].b)] = i;
+            }
+        }
+        for (GridQuad& q : quads) {
+            if (q.dir > 0) continue;
+            auto it = positiveFaces.find(std::make_tuple(q.axis, q.plane, q.a, q.b));
+            if (it != positiveFaces.end() && !quads[it->second].removed) {
+                q.removed = true;
+                quads[it->second].removed = true;
+                stats.hiddenFacesRemoved += 2;
+            }
+        }
+    }
+
+    // 4. 按（平面, 朝向, UV 映射）分组
+    typedef std::tuple<int, int, long, long, long, long, long, long, long> GroupKey;
+    std::map<GroupKey, std::vector<size_t>> groups;
+    for (size_t i = 0; i < quads.size(); i++) {
+        const GridQuad& q = quads[i];
+        if (q.removed) continue;
+        GroupKey key(q.axis, q.dir, q.plane,
+            quantizeUv(q.uv00.x), quantizeUv(q.uv00.y),
+            quantizeUv(q.uvA.x), quantizeUv(q.uvA.y),
+            quantizeUv(q.uvB.x), quantizeUv(q.uvB.y));
+        groups[key].push_back(i);
+    }
+
+    std::vector<MeshData> parts;
+    std::map<std::tuple<long, long, long, long>, size_t> partByTile;
+
+    for (const auto& group : groups) {
+        const GridQuad& first = quads[group.second.front()];
+
+        // 图块矩形 = 单位面的 UV 包围盒
+        glm::vec2 corners[4] = { first.uv00, first.uv00 + first.uvA, first.uv00 + first.uvB,
+                                 first.uv00 + first.uvA + first.uvB };
+        glm::vec2 tileMin = corners[0], tileMax = corners[0];
+        for (const glm::vec2& c : corners) {
+            tileMin = glm::min(tileMin, c);
+            tileMax = glm::max(tileMax, c);
+        }
+        auto tileKey = std::make_tuple(quantizeUv(tileMin.x), quantizeUv(tileMin.y),
+                                       quantizeUv(tileMax.x), quantizeUv(tileMax.y));
+        auto partIt = partByTile.find(tileKey);
+        if (partIt == partByTile.end()) {
+            MeshData part;
+            part.materialIndex = input.materialIndex;
+            part.atlasTiling = true;
+            part.atlasTile = glm::vec4(tileMin, tileMax - tileMin);
+            parts.push_back(part);
+            partIt = partByTile.insert(std::make_pair(tileKey, parts.size() - 1)).first;
+        }
+        MeshData& part = parts[partIt->second];
+
+        // 贪心合并：在占用栅格中逐行扩展矩形
+        long minA = first.a, maxA = first.a, minB = first.b, maxB = first.b;
+        for (size_t i : group.second) {
+            minA = std::min(minA, quads[i].a); maxA = std::max(maxA, quads[i].a);
+            minB = std::min(minB, quads[i].b); maxB = std::max(maxB, quads[i].b);
+        }
+        long width = maxA - minA + 1;
+        long height = maxB - minB + 1;
+
+        if (width * height > (1L << 22)) {
+            // 范围过大时不合并，逐个输出
+            for (size_t i : group.second) {
+                emitQuad(part, quads[i], quads[i].a, quads[i].b, quads[i].a + 1, quads[i].b + 1, origin, cell);
+            }
+            continue;
+        }
+
+        std::vector<char> occupied(width * height, 0);
+        for (size_t i : group.second) {
+            occupied[(quads[i].b - minB) * width + (quads[i].a - minA)] = 1;
+        }
+
+        for (long b = 0; b < height; b++) {
+            for (long a = 0; a < width; a++) {
+                if (!occupied[b * width + a]) continue;
+
+                long w = 1;
+                while (a + w < width && occupied[b * width + a + w]) w++;
+
+                long h = 1;
+                bool canGrow = true;
+                while (b + h < height && canGrow) {
+                    for (long k = 0; k < w; k++) {
+                        if (!occupied[(b + h) * width + a + k]) {
+                            canGrow = false;
+                            break;
+                        }
+                    }
+                    if (canGrow) h++;
+                }
+
+                for (long y = 0; y < h; y++) {
+                    for (long x = 0; x < w; x++) {
+                        occupied[(b + y) * width + a + x] = 0;
+                    }
+                }
+
+                emitQuad(part, first, minA + a, minB + b, minA + a + w, minB + b + h, origin, cell);
+            }
+        }
+    }
+
+    // 5. 未识别的三角形原样保留
+    MeshData rest;
+    rest.materialIndex = input.materialIndex;
+    for (size_t t = 0; t < triangleCount; t++) {
+        if (consumed[t]) continue;
+        for (int k = 0; k < 3; k++) {
+            rest.indices.push_back((unsigned int)rest.vertices.size());
+            rest.vertices.push_back(input.vertices[input.indices[t * 3 + k]]);
+        }
+    }
+
+    stats.trianglesAfter = rest.indices.size() / 3;
+    for (const MeshData& part : parts) {
+        stats.trianglesAfter += part.indices.size() / 3;
+    }
+
+    for (MeshData& part : parts) {
+        output.push_back(std::move(part));
+    }
+    if (!rest.indices.empty()) {
+        output.push_back(std::move(rest));
+    }
+    return true;
+}
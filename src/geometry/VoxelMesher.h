@@ -0,0 +1,27 @@
+#ifndef VOXEL_MESHER_H
+#define VOXEL_MESHER_H
+
+#include "Mesh.h"
+#include <vector>
+#include <cstddef>
+
+// 体素网格优化统计
+struct VoxelMeshStats {
+    size_t trianglesBefore = 0;
+    size_t trianglesAfter = 0;
+    size_t gridQuads = 0;          // 识别出的网格对齐方块面
+    size_t hiddenFacesRemoved = 0; // 剔除的内部面
+    float cellSize = 0.0f;         // 检测到的方块边长
+};
+
+// 体素风格网格（如 Mineways 导出的方块面）优化：
+// 1. 识别网格对齐的单位四边形（两个三角形组成的轴对齐正方形）
+// 2. opaque 为 true 时剔除两个实心方块之间互相贴合的内部面
+// 3. 对同一平面、同一朝向、同一纹理映射的相邻面做贪心合并
+// 合并后的面在纹理图集中的单个图块内重复采样，结果按图块拆分为多个 MeshData
+// （atlasTiling = true，atlasTile 为图块矩形）；无法识别的三角形原样保留。
+// 返回 false 表示网格不是体素网格，此时 output 不会被修改。
+bool optimizeVoxelMesh(const MeshData& input, bool opaque,
+    std::vector<MeshData>& output, VoxelMeshStats& stats);
+
+#endif // VOXEL_MESHER_H
@@ -2,7 +2,7 @@
 #include <vector>
 #include <string>
 #include <cmath>
-#include <fstream>
+#include <algorithm>
 
 #include <glad/glad.h>
 #include <GLFW/glfw3.h>
@@ -19,8 +19,14 @@
 #include "core/Shader.h"
 #include "core/Camera.h"
 #include "core/Texture.h"
+#include "core/AsyncTexture.h"
+#include "core/TextureRegistry.h"
+#include "core/TextureResidency.h"
 #include "core/Model.h"
+#include "core/ModelRegistry.h"
 #include "core/PathUtils.h"
+#include "core/VirtualFileSystem.h"
+#include "core/AssetManifest.h"
 
 // Geometry modules
 #include "geometry/Mesh.h"
@@ -37,8 +43,68 @@
 // 全局变量
 float deltaTime = 0.0f, lastFrame = 0.0f;
 bool useTextureGlobally = true;
+bool meshletCulling = true;
+bool depthPrepass = false;
+bool waitForTextures = false; // 进入主循环前等待启动时提交的纹理全部上传（无渐进加载过程）
+const double textureUploadBudgetMs = 2.0; // 每帧纹理上传时间预算
+const uint32_t treeSeed = 20240611; // 树木布局的随机种子（固定种子，每次启动布局相同）
+const double meshIdleTimeoutSeconds = 10.0; // 树模型网格连续不可见超过该时间后释放 GPU 缓冲
+
+// 命令行参数：--texture-quality full|half|quarter（也接受 --texture-quality=half）
+//             --archive <资源包>（可重复，后指定的优先；未指定时挂载 assets.sfpak，不存在则只读散文件）
+//             --no-texture-compression（不使用 BC1/BC3 块压缩，纹理以未压缩格式上传）
+//             --wait-for-textures（首帧前阻塞上传启动时的纹理，用于截图或对比加载耗时）
+void parseCommandLine(int argc, char** argv) {
+    std::vector<std::string> archives;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        std::string value;
+        if (arg.rfind("--texture-quality=", 0) == 0) {
+            value = arg.substr(arg.find('=') + 1);
+        } else if (arg == "--texture-quality" && i + 1 < argc) {
+            value = argv[++i];
+        } else if (arg.rfind("--archive=", 0) == 0) {
+            archives.push_back(arg.substr(arg.find('=') + 1));
+            continue;
+        } else if (arg == "--archive" && i + 1 < argc) {
+            archives.push_back(argv[++i]);
+            continue;
+        } else if (arg == "--no-texture-compression") {
+            setTextureCompression(false);
+            continue;
+        } else if (arg == "--wait-for-textures") {
+            waitForTextures = true;
+            continue;
+        } else {
+            std::cerr << "Unknown argument: " << arg << std::endl;
+            continue;
+        }
+
+        TextureQuality quality;
+        if (parseTextureQuality(value, quality)) {
+            setTextureQuality(quality);
+        } else {
+            std::cerr << "Unknown texture quality '" << value << "', expected full, half or quarter" << std::endl;
+        }
+    }
+    std::cout << "Texture quality: " << getTextureQualityName(getTextureQuality()) << std::endl;
+
+    if (archives.empty() && virtualFileExists(getResourcePath("assets.sfpak"))) {
+        archives.push_back(getResourcePath("assets.sfpak"));
+    }
+    for (const std::string& archive : archives) {
+        mountArchive(archive);
+    }
+
+    // asset_cook 生成的烘焙清单（预处理后的着色器等）
+    if (virtualFileExists(getResourcePath("asset_manifest.txt"))) {
+        loadAssetManifest(getResourcePath("asset_manifest.txt"));
+    }
+}
+
+int main(int argc, char** argv) {
+    parseCommandLine(argc, argv);
 
-int main() {
     // 初始化GLFW
     if (!glfwInit()) {
         std::cerr << "Failed to init GLFW\n"; return -1;
@@ -61,9 +127,6 @@ int main() {
     glfwSetCursorPosCallback(window, cursor_pos_callback);
     glfwSetKeyCallback(window, key_callback);
     glfwSetInputMode(window, GLFW_CURSOR, GLFW_CURSOR_DISABLED);
-	
-    // 初始化随机数种子（每棵树的数量/大小/高度随机）
-    srand((unsigned int)glfwGetTime());
 
     glEnable(GL_DEPTH_TEST);
 
@@ -82,13 +145,25 @@ int main() {
         return -1;
     }
 
+    // 纹理数组固定使用纹理单元 1，避免与单元 0 上的 sampler2D 冲突
+    basicShader.use();
+    basicShader.setInt("texture_diffuse1", 0);
+    basicShader.setInt("texture_array", 1);
+
     Shader skyboxShader;
     if (!skyboxShader.load("shaders/skybox.vs", "shaders/skybox.fs")) {
         std::cerr << "Failed to load skybox shaders\n";
         return -1;
     }
 
-    // 创建网格
+    Shader depthShader;
+    if (!depthShader.load("shaders/depth.vs", "shaders/depth.fs")) {
+        std::cerr << "Failed to load depth shaders\n";
+        return -1;
+    }
+
+    // 创建网格（附带仅位置流，深度预渲染只读取位置）
+    setPrimitivePositionStreams(true);
     Mesh cube = createCube();
     Mesh roof = createRoof(8.0f, 3.0f, 0.5f);
     Mesh cylinder = createCylinder(20, 1.2f, 0.15f);
@@ -106,16 +181,26 @@ int main() {
         getResourcePath("objects/front.jpg"),
         getResourcePath("objects/back.jpg")
     };
-    unsigned int skyboxTexture = loadCubemap(skyboxFaces);
-
-    // 加载新的纹理文件
-	unsigned int woodTexture = loadTexture(getResourcePath("objects/wood_texture.jpg").c_str());   // 木纹纹理
-	unsigned int barkTexture = loadTexture(getResourcePath("objects/bark_texture.jpg").c_str());    //  树干纹理
-	unsigned int leavesTexture = loadTexture(getResourcePath("objects/leaves_texture.jpg").c_str());   // 树叶纹理
-    unsigned int roofTexture = loadTexture(getResourcePath("objects/roof_shingles.jpg").c_str());        // 屋顶瓦片纹理
-    unsigned int stepTexture = loadTexture(getResourcePath("objects/stone_step.jpg").c_str());          // 石头台阶纹理
-    unsigned int windowGlassTexture = loadTexture(getResourcePath("objects/window_glass.jpg").c_str()); // 玻璃纹理 
-	unsigned int doorTexture = loadTexture(getResourcePath("objects/door.jpg").c_str());              // 木门纹理
+    TextureHandle skyboxTexture = acquireCubemap(skyboxFaces);
+
+    // 加载新的纹理文件（注册表按路径去重；异步解码，先使用占位纹理，主循环中分帧上传）
+	TextureHandle barkTexture = acquireTexture(getResourcePath("objects/bark_texture.jpg"));    //  树干纹理
+	TextureHandle leavesTexture = acquireTexture(getResourcePath("objects/leaves_texture.jpg"));   // 树叶纹理
+
+    // 小屋材质打包为一个纹理数组，材质记录各自的层索引
+    std::vector<std::pair<Color*, std::string>> cabinLayers = {
+        { &woodColor, "objects/wood_texture.jpg" },    // 木纹纹理
+        { &roofColor, "objects/roof_shingles.jpg" },   // 屋顶瓦片纹理
+        { &stepColor, "objects/stone_step.jpg" },      // 石头台阶纹理
+        { &windowColor, "objects/window_glass.jpg" },  // 玻璃纹理
+        { &doorColor, "objects/door.jpg" }             // 木门纹理
+    };
+    std::vector<std::string> cabinLayerPaths;
+    for (auto& layer : cabinLayers) {
+        layer.first->textureLayer = (int)cabinLayerPaths.size();
+        cabinLayerPaths.push_back(getResourcePath(layer.second));
+    }
+    TextureHandle cabinTextures = acquireTextureArray(cabinLayerPaths);
     
     // 光照参数
     glm::vec3 lightDir = glm::normalize(glm::vec3(-0.3f, -1.0f, -0.5f));
@@ -125,54 +210,73 @@ int main() {
     glm::mat4 proj = glm::perspective(glm::radians(60.0f), (float)SCR_WIDTH / SCR_HEIGHT, 0.1f, 10000.0f);
 
     // 生成随机树木位置
-    // 参数说明：树数量, x范围, z范围, 房子X范围(缓冲区), 房子Z范围(缓冲区), 树之间最小距离
+    // 参数说明：树数量, x范围, z范围, 房子X范围(缓冲区), 房子Z范围(缓冲区), 树之间最小距离, 随机种子
     std::vector<Tree> trees = generateRandomTrees(
-        40, -200.0f, 200.0f, -200.0f, 200.0f, 60.0f, 60.0f, 50.0f);
+        40, -200.0f, 200.0f, -200.0f, 200.0f, 60.0f, 60.0f, 50.0f, treeSeed);
 
     // 加载树模型
     Model* treeModel = nullptr;
 #ifdef ASSIMP_AVAILABLE
     std::cout << "=== Assimp is AVAILABLE, attempting to load tree model ===" << std::endl;
+#else
+    std::cout << "=== Assimp is NOT available, loading tree model with the built-in OBJ loader ===" << std::endl;
+#endif
     std::string treeModelPath = getResourcePath("objects/tree.obj");
     std::cout << "Looking for tree model at: " << treeModelPath << std::endl;
     
-    // 检查文件是否存在
-    std::ifstream fileCheck(treeModelPath);
-    if (!fileCheck.good()) {
+    // 检查文件是否存在（资源包或 objects 目录）
+    if (!virtualFileExists(treeModelPath)) {
         std::cerr << "ERROR: Tree model file not found: " << treeModelPath << std::endl;
         std::cerr << "Please ensure tree.obj exists in the objects directory." << std::endl;
     } else {
-        fileCheck.close();
         std::cout << "Tree model file found. Loading..." << std::endl;
     }
     
-    try {
-        treeModel = new Model(treeModelPath);
-        if (treeModel->meshes.empty()) {
-            std::cerr << "Warning: Tree model loaded but has no meshes. Using procedural trees." << std::endl;
-            delete treeModel;
-            treeModel = nullptr;
-        } else {
-            std::cout << "=== Tree model loaded successfully! ===" << std::endl;
-            std::cout << "  Path: " << treeModelPath << std::endl;
-            std::cout << "  Meshes: " << treeModel->meshes.size() << std::endl;
-            std::cout << "  Textures: " << treeModel->textures_loaded.size() << std::endl;
-            std::cout << "  Scale factor: " << treeModel->scaleFactor << std::endl;
-        }
-    } catch (const std::exception& e) {
-        std::cerr << "ERROR: Exception while loading tree model: " << e.what() << std::endl;
-        std::cerr << "Using procedural trees." << std::endl;
-        treeModel = nullptr;
-    } catch (...) {
-        std::cerr << "ERROR: Unknown exception while loading tree model." << std::endl;
-        std::cerr << "Using procedural trees." << std::endl;
-        treeModel = nullptr;
+    // 树模型在线程池上导入与处理，主循环先渲染程序化树木（圆柱 + 圆锥），
+    // CPU 阶段完成后在主线程上传并替换，首帧不再等待模型加载
+    // 树模型实例众多，使用紧凑顶点格式减少顶点带宽与显存
+    ModelImportOptions treeImportOptions;
+    treeImportOptions.vertexFormat = VertexFormat::Compact;
+    treeImportOptions.positionStream = true;
+    treeImportOptions.lazyUpload = true;       // 网格在首次可见（或进入预取半径）时才上传
+    treeImportOptions.prefetchRadius = 100.0f; // 世界单位
+    // 注册表共享句柄：同一文件与选项的其他使用者共享这一份模型；treeModel 每帧从句柄取得
+    ModelHandle treeAsset = acquireModel(treeModelPath, treeImportOptions);
+    ModelAssetStatus treeModelStatus = ModelAssetStatus::Loading;
+
+    // 树木的模型矩阵（深度预渲染与着色 pass 共用）
+    auto modelTreeMatrix = [&](const Tree& tree) {
+        float scale = tree.scale; // 随机缩放因子
+        float finalScale = scale * 15.0f; // 现有比例因子（可调整）
+
+        // 读取模型边界（模型已在加载时计算 bounding box）
+        glm::vec3 modelMin = treeModel->getBoundingBoxMin(); // 本地模型坐标系下最小点
+        float modelScaleFactor = treeModel->scaleFactor;     // 加载时 normalize 得到的 scaleFactor
+
+        // 计算使模型底部贴地的 y 偏移（考虑 normalize 与最终缩放）
+        float yOffset = -modelMin.y * modelScaleFactor * finalScale;
+
+        // 将模型先移动到目标位置（包含 yOffset），再缩放
+        glm::mat4 model = glm::translate(glm::mat4(1.0f), glm::vec3(tree.position.x, tree.position.y + 1.5 * yOffset, tree.position.z));
+        return glm::scale(model, glm::vec3(finalScale));
+    };
+    auto trunkMatrix = [](const Tree& tree) {
+        // 树干 - 应用随机高度
+        glm::mat4 model = glm::translate(glm::mat4(1.0f), tree.position);
+        model = glm::translate(model, glm::vec3(0.0f, 0.2f * tree.scale, 0.0f)); // 高度随机
+        return glm::scale(model, glm::vec3(1.0f * tree.scale, 1.2f * tree.scale, 1.0f * tree.scale)); // 整体随机缩放
+    };
+    auto crownMatrix = [](const Tree& tree) {
+        // 树冠 - 应用随机大小
+        glm::mat4 model = glm::translate(glm::mat4(1.0f), glm::vec3(tree.position.x, 1.2f * tree.scale, tree.position.z));
+        return glm::scale(model, glm::vec3(0.8f * tree.scale, 1.2f * tree.scale, 0.8f * tree.scale)); // 树冠随机缩放
+    };
+
+    if (waitForTextures) {
+        double waitStart = glfwGetTime();
+        finishTextureUploads();
+        std::cout << "Startup textures uploaded in " << (glfwGetTime() - waitStart) * 1000.0 << " ms" << std::endl;
     }
-#else
-    std::cout << "=== Assimp is NOT available ===" << std::endl;
-    std::cout << "Model loading is disabled. Using procedural trees." << std::endl;
-    std::cout << "To enable model loading, please install Assimp library and reconfigure CMake." << std::endl;
-#endif
 
     // 主循环
     while (!glfwWindowShouldClose(window)) {
@@ -182,9 +286,86 @@ int main() {
 
         processInput(deltaTime);
 
+        // 上传后台线程已解码完成的纹理（限制每帧耗时，避免加载期间卡顿）
+        processTextureUploads(textureUploadBudgetMs);
+
+        // 树模型 CPU 处理完成后上传，之后替换程序化树木（卸载或加载失败时退回程序化树木）
+        processModelLoads();
+        treeModel = treeAsset->get();
+        if (treeAsset->status != treeModelStatus) {
+            treeModelStatus = treeAsset->status;
+            if (treeModelStatus == ModelAssetStatus::Ready) {
+                std::cout << "=== Tree model loaded successfully! ===" << std::endl;
+                std::cout << "  Path: " << treeModelPath << std::endl;
+                std::cout << "  Meshes: " << treeModel->meshes.size() << std::endl;
+                std::cout << "  Textures: " << treeModel->textures_loaded.size() << std::endl;
+                std::cout << "  Scale factor: " << treeModel->scaleFactor << std::endl;
+            } else if (treeModelStatus == ModelAssetStatus::Failed) {
+                std::cerr << "Warning: Tree model failed to load or has no meshes. Using procedural trees." << std::endl;
+            }
+        }
+
+        // 长时间不可见的树模型网格退回 CPU / 映射缓存
+        if (treeModel != nullptr) {
+            treeModel->releaseIdleMeshes(meshIdleTimeoutSeconds);
+        }
+
+        // 纹理仍在渐进上传时，按物体在屏幕上的尺寸决定先补全哪张纹理的高分辨率 mip
+        if (pendingTextureCount() > 0) {
+            // 包围球投影直径（像素）：2r / (2d·tan(fov/2)) · 屏幕高度
+            auto screenSize = [&](const glm::vec3& center, float radius) {
+                float distance = std::max(glm::length(center - camera.pos), radius);
+                return radius * SCR_HEIGHT / (distance * std::tan(glm::radians(30.0f)));
+            };
+            setTextureScreenSize(cabinTextures->id, screenSize(glm::vec3(0.0f, 2.0f, 0.0f), 4.0f));
+
+            float treeScreenSize = 0.0f;
+            for (const Tree& tree : trees) {
+                treeScreenSize = std::max(treeScreenSize, screenSize(tree.position, 8.0f * tree.scale));
+            }
+            setTextureScreenSize(barkTexture->id, treeScreenSize);
+            setTextureScreenSize(leavesTexture->id, treeScreenSize);
+            if (treeModel != nullptr) {
+                for (const Texture& texture : treeModel->textures_loaded) {
+                    setTextureScreenSize(texture.id, treeScreenSize);
+                }
+            }
+        }
+
         glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
         glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
+        glm::mat4 viewProj = proj * camera.getView();
+
+        // -------------------- 深度预渲染 --------------------
+        // 只绑定仅位置流写入树木深度，着色 pass 以 GL_LEQUAL 复用，避免被遮挡片段的着色开销
+        if (depthPrepass) {
+            glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
+            depthShader.use();
+            depthShader.setMat4("proj", proj);
+            depthShader.setMat4("view", camera.getView());
+
+            if (treeModel != nullptr) {
+                for (auto& tree : trees) {
+                    treeModel->DrawDepth(depthShader, modelTreeMatrix(tree), viewProj, camera.pos);
+                }
+            } else {
+                for (auto& tree : trees) {
+                    depthShader.setMat4("model", trunkMatrix(tree));
+                    bindDepthVertexArray(cylinder);
+                    glDrawElements(GL_TRIANGLES, cylinder.indexCount, cylinder.indexType, 0);
+
+                    depthShader.setMat4("model", crownMatrix(tree));
+                    bindDepthVertexArray(cone);
+                    glDrawElements(GL_TRIANGLES, cone.indexCount, cone.indexType, 0);
+                }
+            }
+            glBindVertexArray(0);
+
+            glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+            glDepthFunc(GL_LEQUAL);
+        }
+
         // 绘制场景物体
         basicShader.use();
         basicShader.setVec3("lightDir", lightDir);
@@ -194,34 +375,23 @@ int main() {
         basicShader.setMat4("view", camera.getView());
 
         // -------------------- 绘制小屋 --------------------
-        glActiveTexture(GL_TEXTURE0);
-        glBindTexture(GL_TEXTURE_2D, woodTexture);
-        basicShader.setInt("texture_diffuse1", 0);
-
-        renderDetailedHouse(basicShader, cube, roof, windowMesh, doorMesh, useTextureGlobally,
-            woodTexture, roofTexture, stepTexture, windowGlassTexture, doorTexture);
+        renderDetailedHouse(basicShader, cube, roof, windowMesh, doorMesh, useTextureGlobally, cabinTextures->id);
+        markTextureUsed(cabinTextures);
 
         
         // -------------------- 绘制树木 --------------------
+        MeshletCullStats meshletStats;
         if (treeModel != nullptr) {
+            for (const Texture& texture : treeModel->textures_loaded) {
+                markTextureUsed(texture.handle);
+            }
+            if (treeModel->textures_loaded.empty()) {
+                markTextureUsed(leavesTexture);
+            }
+
             // 使用加载的模型渲染树木
             for (auto& tree : trees) {
-                float scale = tree.scale; // 随机缩放因子
-                float finalScale = scale * 15.0f; // 现有比例因子（可调整）
-
-                // 读取模型边界（模型已在加载时计算 bounding box）
-                glm::vec3 modelMin = treeModel->getBoundingBoxMin(); // 本地模型坐标系下最小点
-                float modelScaleFactor = treeModel->scaleFactor;     // 加载时 normalize 得到的 scaleFactor
-
-                // 计算使模型底部贴地的 y 偏移（考虑 normalize 与最终缩放）
-                float yOffset = -modelMin.y * modelScaleFactor * finalScale;
-
-                // 将模型先移动到目标位置（包含 yOffset），再缩放
-                glm::mat4 model = glm::translate(glm::mat4(1.0f), glm::vec3(tree.position.x, tree.position.y + 1.5 * yOffset, tree.position.z));
-                
-                // 应用缩放
-                model = glm::scale(model, glm::vec3(finalScale));
-                
+                glm::mat4 model = modelTreeMatrix(tree);
                 basicShader.setMat4("model", model);
                 
                 // 设置材质（使用树干材质作为默认）
@@ -234,7 +404,7 @@ int main() {
                 if (!treeModel->textures_loaded.empty()) {
                     glBindTexture(GL_TEXTURE_2D, treeModel->textures_loaded[0].id); // 使用模型自带的纹理
                 } else {
-                    glBindTexture(GL_TEXTURE_2D, leavesTexture); // 后备纹理
+                    glBindTexture(GL_TEXTURE_2D, leavesTexture->id); // 后备纹理
                 }
                 basicShader.setInt("texture_diffuse1", 0);
                 basicShader.setBool("useTexture", useTextureGlobally);
@@ -246,24 +416,25 @@ int main() {
                     basicShader.setVec3("material.diffuse", glm::vec3(1.0f));
                 }
                 
-                // 绘制模型
-                treeModel->Draw(basicShader);
+                // 绘制模型（meshlet 剔除：视锥外与背向相机的簇不提交）
+                if (meshletCulling) {
+                    treeModel->DrawCulled(basicShader, model, viewProj, camera.pos, &meshletStats);
+                } else {
+                    treeModel->Draw(basicShader);
+                }
             }
         } else {
+            markTextureUsed(barkTexture);
+            markTextureUsed(leavesTexture);
+
             // 使用原有的程序化几何体渲染树木（保持向后兼容）
             for (auto& tree : trees) {
-                float scale = tree.scale; // 获取随机缩放因子
-
-                // 树干 - 应用随机高度
-                glm::mat4 model = glm::translate(glm::mat4(1.0f), tree.position);
-                model = glm::translate(model, glm::vec3(0.0f, 0.2f * scale, 0.0f)); // 高度随机
-                model = glm::scale(model, glm::vec3(1.0f * scale, 1.2f * scale, 1.0f * scale)); // 整体随机缩放
-
-                basicShader.setMat4("model", model);
+                // 树干
+                basicShader.setMat4("model", trunkMatrix(tree));
 
                 // 绑定树干纹理，设置纹理开关
                 glActiveTexture(GL_TEXTURE0);
-                glBindTexture(GL_TEXTURE_2D, barkTexture);
+                glBindTexture(GL_TEXTURE_2D, barkTexture->id);
                 basicShader.setBool("useTexture", useTextureGlobally);
 
                 // 设置材质
@@ -280,17 +451,14 @@ int main() {
                 }
 
                 glBindVertexArray(cylinder.VAO);
-                glDrawElements(GL_TRIANGLES, cylinder.indexCount, GL_UNSIGNED_INT, 0);
-
-                // 树冠 - 应用随机大小
-                model = glm::translate(glm::mat4(1.0f), glm::vec3(tree.position.x, 1.2f * scale, tree.position.z));
-                model = glm::scale(model, glm::vec3(0.8f * scale, 1.2f * scale, 0.8f * scale)); // 树冠随机缩放
+                glDrawElements(GL_TRIANGLES, cylinder.indexCount, cylinder.indexType, 0);
 
-                basicShader.setMat4("model", model);
+                // 树冠
+                basicShader.setMat4("model", crownMatrix(tree));
 
                 // 绑定树冠纹理，设置纹理开关
                 glActiveTexture(GL_TEXTURE0);
-                glBindTexture(GL_TEXTURE_2D, leavesTexture);
+                glBindTexture(GL_TEXTURE_2D, leavesTexture->id);
                 basicShader.setBool("useTexture", useTextureGlobally);
 
                 // 设置材质
@@ -307,7 +475,7 @@ int main() {
                 }
 
                 glBindVertexArray(cone.VAO);
-                glDrawElements(GL_TRIANGLES, cone.indexCount, GL_UNSIGNED_INT, 0);
+                glDrawElements(GL_TRIANGLES, cone.indexCount, cone.indexType, 0);
             }
         }
 
@@ -324,19 +492,41 @@ int main() {
 
         glBindVertexArray(skybox.VAO);
         glActiveTexture(GL_TEXTURE0);
-        glBindTexture(GL_TEXTURE_CUBE_MAP, skyboxTexture);
+        glBindTexture(GL_TEXTURE_CUBE_MAP, skyboxTexture->id);
         glDrawArrays(GL_TRIANGLES, 0, skybox.indexCount);
         glBindVertexArray(0);
+        markTextureUsed(skyboxTexture);
 
         glDepthFunc(GL_LESS);
         glDepthMask(GL_TRUE);
 
+        // 纹理显存超出预算时降级最久未使用的纹理，预算有余量时恢复本帧用到的纹理
+        updateTextureResidency();
+
         ImGui_ImplOpenGL3_NewFrame();
         ImGui_ImplGlfw_NewFrame();
         ImGui::NewFrame();
 
         ImGui::Begin("Scene Control");
         ImGui::Text("FPS: %.1f", 1.0f / deltaTime);
+        size_t texturesPending = pendingTextureCount();
+        if (texturesPending > 0) {
+            ImGui::Text("Textures loading: %zu", texturesPending);
+        }
+        if (treeAsset->pending) {
+            ImGui::Text("Tree model loading...");
+        }
+        if (treeModel != nullptr) {
+            ImGui::Text("Tree meshes resident: %zu / %zu, %.2f MB", treeModel->getResidentMeshCount(),
+                treeModel->meshes.size(), treeModel->getResidentMeshBytes() / (1024.0 * 1024.0));
+        }
+        ImGui::Separator();
+
+        ImGui::Checkbox("Meshlet Culling", &meshletCulling);
+        ImGui::Checkbox("Depth Prepass (Trees)", &depthPrepass);
+        if (meshletCulling && meshletStats.total > 0) {
+            ImGui::Text("Meshlets drawn: %zu / %zu", meshletStats.visible, meshletStats.total);
+        }
         ImGui::Separator();
 
         // Global texture toggle
@@ -357,6 +547,74 @@ int main() {
         ImGui::Text("Lighting");
         ImGui::SliderFloat3("Light Direction", (float*)&lightDir.x, -1.0f, 1.0f);
         ImGui::ColorEdit3("Light Color", (float*)&lightColor);
+        ImGui::Separator();
+
+        // 纹理显存（注册表中存活的纹理）
+        if (ImGui::CollapsingHeader("Textures")) {
+            std::vector<TextureRecord> textureRecords = getTextureRecords();
+            size_t textureBytes = 0;
+            for (const TextureRecord& record : textureRecords) {
+                textureBytes += record.vramBytes;
+            }
+            ImGui::Text("Textures: %zu, VRAM: %.2f MB, quality: %s", textureRecords.size(),
+                textureBytes / (1024.0 * 1024.0), getTextureQualityName(getTextureQuality()));
+            for (const TextureRecord& record : textureRecords) {
+                std::string name = record.path.substr(record.path.find_last_of('/') + 1);
+                ImGui::Text("%s  %dx%d  %.2f MB  refs %ld%s", name.c_str(), record.width, record.height,
+                    record.vramBytes / (1024.0 * 1024.0), record.references, record.loading ? "  (loading)" : "");
+            }
+        }
+
+        // 模型资源：每份共享模型的内存，可卸载 / 重新加载
+        if (ImGui::CollapsingHeader("Models")) {
+            size_t modelGpuBytes = 0, modelCpuBytes = 0;
+            std::vector<ModelRecord> modelRecords = getModelRecords();
+            for (const ModelRecord& record : modelRecords) {
+                modelGpuBytes += record.gpuBytes;
+                modelCpuBytes += record.cpuBytes;
+            }
+            ImGui::Text("Models: %zu, mesh VRAM: %.2f MB, CPU: %.2f MB", modelRecords.size(),
+                modelGpuBytes / (1024.0 * 1024.0), modelCpuBytes / (1024.0 * 1024.0));
+            for (const ModelHandle& asset : getLiveModels()) {
+                const Model* model = asset->get();
+                std::string name = asset->path.substr(asset->path.find_last_of('/') + 1);
+                ImGui::PushID(asset->key.c_str());
+                ImGui::Text("%s  %s  refs %ld", name.c_str(), getModelAssetStatusName(asset->status),
+                    asset.use_count() - 1); // 不计 getLiveModels 持有的引用
+                if (model != nullptr) {
+                    ImGui::Text("  meshes %zu / %zu  GPU %.2f MB  CPU %.2f MB  mapped %.2f MB",
+                        model->getResidentMeshCount(), model->meshes.size(),
+                        model->getResidentMeshBytes() / (1024.0 * 1024.0), model->getCpuMemoryBytes() / (1024.0 * 1024.0),
+                        model->getMappedCacheBytes() / (1024.0 * 1024.0));
+                }
+                if (ImGui::Button("Unload")) {
+                    unloadModel(asset);
+                }
+                ImGui::SameLine();
+                if (ImGui::Button("Reload")) {
+                    reloadModel(asset);
+                }
+                ImGui::PopID();
+            }
+        }
+
+        // 纹理驻留：显存预算、每张纹理当前驻留的 mip 级别
+        if (ImGui::CollapsingHeader("Texture Residency")) {
+            int budgetMB = (int)(getTextureBudget() / (1024 * 1024));
+            if (ImGui::SliderInt("Budget (MB)", &budgetMB, 1, 1024)) {
+                setTextureBudget((size_t)budgetMB * 1024 * 1024);
+            }
+            ImGui::Text("Resident: %.2f / %d MB", getResidentTextureMemory() / (1024.0 * 1024.0), budgetMB);
+            for (const TextureResidencyRecord& record : getTextureResidency()) {
+                std::string name = record.path.substr(record.path.find_last_of('/') + 1);
+                const char* status = record.loading ? "  (streaming)"
+                    : (record.residentLevel > 0 ? "  (downgraded)" : "");
+                ImGui::Text("%s  %dx%d  mip %d/%d  %.2f / %.2f MB  idle %llu%s", name.c_str(),
+                    record.width, record.height, record.residentLevel, std::max(record.levelCount - 1, 0),
+                    record.residentBytes / (1024.0 * 1024.0), record.fullBytes / (1024.0 * 1024.0),
+                    (unsigned long long)record.framesSinceUse, status);
+            }
+        }
 
         if (ImGui::Button(captureMouse ? "Release Mouse" : "Capture Mouse")) {
             captureMouse = !captureMouse;
@@ -376,10 +634,13 @@ int main() {
         glfwPollEvents();
     }
 
-    // 清理
-    if (treeModel != nullptr) {
-        delete treeModel;
-    }
+    // 清理（仍在加载的树模型由工作线程完成后释放）
+    treeModel = nullptr;
+    treeAsset.reset();
+    shutdownModelRegistry();
+    shutdownTextureRegistry();
+    shutdownTextureLoader();
+    unmountArchives();
     ImGui_ImplOpenGL3_Shutdown();
     ImGui_ImplGlfw_Shutdown();
     ImGui::DestroyContext();
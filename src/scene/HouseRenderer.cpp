@@ -4,36 +4,35 @@
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 
+// 设置部件材质：有纹理层时采样纹理数组，否则使用纯色
+static void applyMaterial(Shader& shader, const Color& color, bool useTexture) {
+    bool textured = useTexture && color.textureLayer >= 0;
+    shader.setBool("useTexture", textured);
+    shader.setFloat("textureLayer", (float)color.textureLayer);
+    shader.setVec3("material.diffuse", textured ? glm::vec3(1.0f) : color.diffuse);
+    shader.setVec3("material.ambient", color.ambient);
+    shader.setVec3("material.specular", color.specular);
+    shader.setFloat("material.shininess", color.shininess);
+}
+
 void renderDetailedHouse(Shader& shader, Mesh& cube, Mesh& roof, Mesh& windowMesh, Mesh& doorMesh,
-    bool useTexture, unsigned int woodTex, unsigned int roofTex, unsigned int stepTex, 
-    unsigned int windowTex, unsigned int doorTex)
+    bool useTexture, unsigned int cabinTextures)
 {
-    // 在每个物体渲染前都要设置纹理采样器
-    shader.setInt("texture_diffuse1", 0);
+    // 整栋小屋共用一个纹理数组，只绑定一次
+    glActiveTexture(GL_TEXTURE1);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, cabinTextures);
+    shader.setInt("texture_array", 1);
+    shader.setBool("useTextureArray", true);
     
     // -------------------- 1. 小屋主体 --------------------
     glm::mat4 model = glm::mat4(1.0f);
     model = glm::translate(model, glm::vec3(0.0f, 2.0f, 0.0f));
     model = glm::scale(model, glm::vec3(4.0f, 3.0f, 5.0f));
     shader.setMat4("model", model);
-
-    shader.setBool("useTexture", useTexture);
-    shader.setVec3("material.ambient", woodColor.ambient);
-    shader.setVec3("material.specular", woodColor.specular);
-    shader.setFloat("material.shininess", woodColor.shininess);
-
-    // 绑定木纹纹理
-    glActiveTexture(GL_TEXTURE0);
-    if (useTexture) {
-        glBindTexture(GL_TEXTURE_2D, woodTex);
-        shader.setVec3("material.diffuse", glm::vec3(1.0f));
-    } else {
-        glBindTexture(GL_TEXTURE_2D, 0); // 绑定空纹理
-        shader.setVec3("material.diffuse", woodColor.diffuse);
-    }
+    applyMaterial(shader, woodColor, useTexture);
 
     glBindVertexArray(cube.VAO);
-    glDrawElements(GL_TRIANGLES, cube.indexCount, GL_UNSIGNED_INT, 0);
+    glDrawElements(GL_TRIANGLES, cube.indexCount, cube.indexType, 0);
 
     // -------------------- 2. 屋顶 --------------------
     model = glm::mat4(1.0f);
@@ -41,41 +40,19 @@ void renderDetailedHouse(Shader& shader, Mesh& cube, Mesh& roof, Mesh& windowMes
 	model = glm::scale(model, glm::vec3(0.8f, 1.1f, 2.2f));// 调整屋顶大小以覆盖主体
     
     shader.setMat4("model", model);
-
-    // 绑定屋顶纹理
-    glActiveTexture(GL_TEXTURE0);
-    if (useTexture) {
-        glBindTexture(GL_TEXTURE_2D, roofTex);
-        shader.setBool("useTexture", true);
-        shader.setVec3("material.diffuse", glm::vec3(1.0f));
-    } else {
-        glBindTexture(GL_TEXTURE_2D, 0);
-        shader.setBool("useTexture", false);
-        shader.setVec3("material.diffuse", roofColor.diffuse);
-    }
-
-    shader.setVec3("material.ambient", roofColor.ambient);
-    shader.setVec3("material.specular", roofColor.specular);
-    shader.setFloat("material.shininess", roofColor.shininess);
+    applyMaterial(shader, roofColor, useTexture);
 
     glBindVertexArray(roof.VAO);
-    glDrawElements(GL_TRIANGLES, roof.indexCount, GL_UNSIGNED_INT, 0);
+    glDrawElements(GL_TRIANGLES, roof.indexCount, roof.indexType, 0);
 
     // -------------------- 3. 烟囱 --------------------
     model = glm::translate(glm::mat4(1.0f), glm::vec3(1.3f, 4.7f, 1.7f));
     model = glm::scale(model, glm::vec3(0.35f, 0.8f, 0.35f));
     shader.setMat4("model", model);
-
-    shader.setBool("useTexture", false); // 烟囱强制纯色
-    glBindTexture(GL_TEXTURE_2D, 0); // 确保没有绑定纹理
-
-    shader.setVec3("material.ambient", chimneyColor.ambient);
-    shader.setVec3("material.diffuse", chimneyColor.diffuse);
-    shader.setVec3("material.specular", chimneyColor.specular);
-    shader.setFloat("material.shininess", chimneyColor.shininess);
+    applyMaterial(shader, chimneyColor, useTexture); // 烟囱没有纹理层，强制纯色
     
     glBindVertexArray(cube.VAO);
-    glDrawElements(GL_TRIANGLES, cube.indexCount, GL_UNSIGNED_INT, 0);
+    glDrawElements(GL_TRIANGLES, cube.indexCount, cube.indexType, 0);
 
     // -------------------- 4. 前门 --------------------
     model = glm::mat4(1.0f);
@@ -83,42 +60,13 @@ void renderDetailedHouse(Shader& shader, Mesh& cube, Mesh& roof, Mesh& windowMes
     model = glm::scale(model, glm::vec3(1.6f, 1.5f, 0.1f)); // 宽高深参数
     // 移除旋转，让门正对相机
     shader.setMat4("model", model);
-
-    // 绑定门纹理
-    glActiveTexture(GL_TEXTURE0);
-    if (useTexture) {
-        glBindTexture(GL_TEXTURE_2D, doorTex);
-        shader.setBool("useTexture", true);
-        shader.setVec3("material.diffuse", glm::vec3(1.0f));
-    } else {
-        glBindTexture(GL_TEXTURE_2D, 0);
-        shader.setBool("useTexture", false);
-        shader.setVec3("material.diffuse", doorColor.diffuse);
-    }
-
-    shader.setVec3("material.ambient", doorColor.ambient);
-    shader.setVec3("material.specular", doorColor.specular);
-    shader.setFloat("material.shininess", doorColor.shininess);
+    applyMaterial(shader, doorColor, useTexture);
 
     glBindVertexArray(doorMesh.VAO);
-    glDrawElements(GL_TRIANGLES, doorMesh.indexCount, GL_UNSIGNED_INT, 0);
+    glDrawElements(GL_TRIANGLES, doorMesh.indexCount, doorMesh.indexType, 0);
 
     // -------------------- 5. 窗户 --------------------
-    // 绑定窗户纹理
-    glActiveTexture(GL_TEXTURE0);
-    if (useTexture) {
-        glBindTexture(GL_TEXTURE_2D, windowTex);
-        shader.setBool("useTexture", true);
-        shader.setVec3("material.diffuse", glm::vec3(1.0f));
-    } else {
-        glBindTexture(GL_TEXTURE_2D, 0);
-        shader.setBool("useTexture", false);
-        shader.setVec3("material.diffuse", windowColor.diffuse);
-    }
-
-    shader.setVec3("material.ambient", windowColor.ambient);
-    shader.setVec3("material.specular", windowColor.specular);
-    shader.setFloat("material.shininess", windowColor.shininess);
+    applyMaterial(shader, windowColor, useTexture);
 
     // 窗户 1
     model = glm::mat4(1.0f);
@@ -126,7 +74,7 @@ void renderDetailedHouse(Shader& shader, Mesh& cube, Mesh& roof, Mesh& windowMes
     model = glm::scale(model, glm::vec3(1.5f, 1.5f, 0.1f));
     shader.setMat4("model", model);
     glBindVertexArray(windowMesh.VAO);
-    glDrawElements(GL_TRIANGLES, windowMesh.indexCount, GL_UNSIGNED_INT, 0);
+    glDrawElements(GL_TRIANGLES, windowMesh.indexCount, windowMesh.indexType, 0);
 
     // 窗户 2
     model = glm::mat4(1.0f);
@@ -134,30 +82,18 @@ void renderDetailedHouse(Shader& shader, Mesh& cube, Mesh& roof, Mesh& windowMes
     model = glm::scale(model, glm::vec3(1.5f, 1.5f, 0.1f));
     shader.setMat4("model", model);
     glBindVertexArray(windowMesh.VAO);
-    glDrawElements(GL_TRIANGLES, windowMesh.indexCount, GL_UNSIGNED_INT, 0);
+    glDrawElements(GL_TRIANGLES, windowMesh.indexCount, windowMesh.indexType, 0);
 
     // -------------------- 6. 台阶 --------------------
     model = glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, 0.5f, 3.0f));
     model = glm::scale(model, glm::vec3(1.2f, 0.1f, 1.5f));
     shader.setMat4("model", model);
-
-    // 绑定台阶纹理
-    glActiveTexture(GL_TEXTURE0);
-    if (useTexture) {
-        glBindTexture(GL_TEXTURE_2D, stepTex);
-        shader.setBool("useTexture", true);
-        shader.setVec3("material.diffuse", glm::vec3(1.0f));
-    } else {
-        glBindTexture(GL_TEXTURE_2D, 0);
-        shader.setBool("useTexture", false);
-        shader.setVec3("material.diffuse", stepColor.diffuse);
-    }
-
-    shader.setVec3("material.ambient", stepColor.ambient);
-    shader.setVec3("material.specular", stepColor.specular);
-    shader.setFloat("material.shininess", stepColor.shininess);
+    applyMaterial(shader, stepColor, useTexture);
 
     glBindVertexArray(cube.VAO);
-    glDrawElements(GL_TRIANGLES, cube.indexCount, GL_UNSIGNED_INT, 0);
-}
+    glDrawElements(GL_TRIANGLES, cube.indexCount, cube.indexType, 0);
 
+    // 之后的物体（树木、模型）仍使用单张 2D 纹理
+    shader.setBool("useTextureArray", false);
+    glActiveTexture(GL_TEXTURE0);
+}
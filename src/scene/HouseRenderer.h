@@ -4,9 +4,10 @@
 #include "../core/Shader.h"
 #include "../geometry/Mesh.h"
 
+// cabinTextures 为小屋材质的 GL_TEXTURE_2D_ARRAY（绑定到纹理单元 1），
+// 各部件通过材质的 textureLayer 选择数组层，整栋小屋只绑定一次纹理
 void renderDetailedHouse(Shader& shader, Mesh& cube, Mesh& roof, Mesh& windowMesh, Mesh& doorMesh,
-    bool useTexture, unsigned int woodTex, unsigned int roofTex, unsigned int stepTex, 
-    unsigned int windowTex, unsigned int doorTex);
+    bool useTexture, unsigned int cabinTextures);
 
 #endif // HOUSE_RENDERER_H
 
@@ -8,6 +8,7 @@ struct Color {
     glm::vec3 diffuse;
     glm::vec3 specular;
     float shininess;
+    int textureLayer = -1; // 所在纹理数组层（-1 表示纯色，不采样纹理）
 };
 
 // 材质定义
@@ -1,42 +1,180 @@
 #include "Tree.h"
 #include <glm/gtc/type_ptr.hpp>
 #include <cmath>
-#include <cstdlib>
+#include <cstdint>
+#include <random>
+#include <chrono>
+#include <iostream>
+#include <algorithm>
 
-std::vector<Tree> generateRandomTrees(
-    int treeCount, float xMin, float xMax,
-    float zMin, float zMax,
-    float houseXRange, float houseZRange,
-    float minDistance) {
-
-    std::vector<Tree> trees;
+namespace {
 
-    while (trees.size() < treeCount) {
-        float randX = xMin + static_cast<float>(rand()) / (static_cast<float>(RAND_MAX / (xMax - xMin)));
-        float randZ = zMin + static_cast<float>(rand()) / (static_cast<float>(RAND_MAX / (zMax - zMin)));
+// Bridson 泊松圆盘采样的区域：矩形范围减去房子周围的矩形空洞
+struct PlacementDomain {
+    float xMin, xMax, zMin, zMax;
+    float houseXRange, houseZRange;
 
+    bool contains(float x, float z) const {
+        if (x < xMin || x >= xMax || z < zMin || z >= zMax) return false;
         // 避开房子区域（增加安全距离，确保树不会太靠近房子）
-        // 使用更大的缓冲区范围，让树与房子保持更远的距离
-        if (std::abs(randX) < houseXRange && std::abs(randZ) < houseZRange) {
+        return !(std::abs(x) < houseXRange && std::abs(z) < houseZRange);
+    }
+
+    float usableArea() const {
+        float area = (xMax - xMin) * (zMax - zMin);
+        float holeX = std::max(0.0f, std::min(xMax, houseXRange) - std::max(xMin, -houseXRange));
+        float holeZ = std::max(0.0f, std::min(zMax, houseZRange) - std::max(zMin, -houseZRange));
+        return std::max(0.0f, area - holeX * holeZ);
+    }
+};
+
+const int kCandidateAttempts = 8;  // 每个活动点在 r 外侧的候选次数（角度均匀分布时 8 个方向已足够填满）
+const int kSeedAttempts = 64;      // 活动列表清空后，为被空洞隔开的区域重新播种的尝试次数
+const float kEmptyCell = 1e30f;    // 空单元的坐标：与任何点的距离都足够远，判断时无需分支
+
+// 以间距 radius 填满区域，返回全部采样点（x, z）。背景网格单元边长 r/√2，每个单元至多一个点，
+// 点坐标直接存放在单元中，检查邻近 5x5 单元即可判断最小距离。
+// 与原始 Bridson 相比：候选点取在 [r, 1.1r] 的圆环上、角度从随机起点均匀分布，接受率高得多；
+// 活动列表按后进先出处理，访问的网格单元在内存中相邻。每个点最多尝试 kCandidateAttempts 次，期望 O(n)
+std::vector<glm::vec2> samplePoissonDisk(const PlacementDomain& domain, float radius, std::mt19937& rng) {
+    std::vector<glm::vec2> points;
+    float cellSize = radius / std::sqrt(2.0f);
+    int gridWidth = std::max(1, (int)std::ceil((domain.xMax - domain.xMin) / cellSize));
+    int gridHeight = std::max(1, (int)std::ceil((domain.zMax - domain.zMin) / cellSize));
+    // 四周各留 2 个单元的边框，邻域检查不需要裁剪
+    int stride = gridWidth + 4;
+    std::vector<glm::vec2> grid((size_t)stride * (gridHeight + 4), glm::vec2(kEmptyCell));
+    std::vector<glm::vec2> active;
+
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    float radiusSquared = radius * radius;
+    float inverseCellSize = 1.0f / cellSize;
+
+    auto cellIndex = [&](const glm::vec2& p) {
+        int cx = std::min(gridWidth - 1, (int)((p.x - domain.xMin) * inverseCellSize));
+        int cz = std::min(gridHeight - 1, (int)((p.y - domain.zMin) * inverseCellSize));
+        return (size_t)(cz + 2) * stride + (cx + 2);
+    };
+    // 邻域 5x5 去掉四角（四角单元中的点与候选点的距离不小于 r），由近到远排列以便尽早拒绝
+    ptrdiff_t neighbors[21];
+    int neighborCount = 0;
+    for (int ring = 0; ring < 8; ring++) {
+        for (int z = -2; z <= 2; z++) {
+            for (int x = -2; x <= 2; x++) {
+                if (x * x + z * z == ring) neighbors[neighborCount++] = (ptrdiff_t)z * stride + x;
+            }
+        }
+    }
+    auto isFarEnough = [&](const glm::vec2& p, size_t cell) {
+        const glm::vec2* center = &grid[cell];
+        for (int i = 0; i < neighborCount; i++) {
+            glm::vec2 d = center[neighbors[i]] - p;
+            if (d.x * d.x + d.y * d.y < radiusSquared) return false;
+        }
+        return true;
+    };
+    auto addPoint = [&](const glm::vec2& p, size_t cell) {
+        grid[cell] = p;
+        active.push_back(p);
+        points.push_back(p);
+    };
+
+    // 候选点：角度均匀分布，距离在 [r, 1.1r] 内交错
+    glm::vec2 candidateOffsets[kCandidateAttempts];
+    for (int i = 0; i < kCandidateAttempts; i++) {
+        float angle = i * (6.28318531f / kCandidateAttempts);
+        float distance = radius * (1.0f + 0.1f * (float)((i * 5) % kCandidateAttempts) / kCandidateAttempts);
+        candidateOffsets[i] = distance * glm::vec2(std::cos(angle), std::sin(angle));
+    }
+
+    int seedAttempts = kSeedAttempts;
+    while (seedAttempts > 0) {
+        if (active.empty()) {
+            // 在整个区域随机播种；失败次数用尽即结束（区域已填满或没有可用面积）
+            glm::vec2 seed(domain.xMin + unit(rng) * (domain.xMax - domain.xMin),
+                domain.zMin + unit(rng) * (domain.zMax - domain.zMin));
+            size_t cell = cellIndex(seed);
+            if (domain.contains(seed.x, seed.y) && isFarEnough(seed, cell)) {
+                addPoint(seed, cell);
+            } else {
+                seedAttempts--;
+            }
             continue;
         }
 
-        // 检查与其他树木的距离
-        bool isTooClose = false;
-        for (const auto& tree : trees) {
-            float distance = glm::distance(glm::vec2(randX, randZ), glm::vec2(tree.position.x, tree.position.z));
-            if (distance < minDistance) {
-                isTooClose = true;
+        // 候选方向表整体旋转一个随机角度（每个点只计算一次 sin / cos）
+        glm::vec2 origin = active.back();
+        float startAngle = unit(rng) * 6.28318531f;
+        glm::vec2 rotation(std::cos(startAngle), std::sin(startAngle));
+        bool placed = false;
+        for (int attempt = 0; attempt < kCandidateAttempts; attempt++) {
+            const glm::vec2& offset = candidateOffsets[attempt];
+            glm::vec2 candidate = origin + glm::vec2(offset.x * rotation.x - offset.y * rotation.y,
+                offset.x * rotation.y + offset.y * rotation.x);
+            if (!domain.contains(candidate.x, candidate.y)) continue;
+            size_t cell = cellIndex(candidate);
+            if (isFarEnough(candidate, cell)) {
+                addPoint(candidate, cell);
+                placed = true;
                 break;
             }
         }
+        if (!placed) {
+            // 新点被加入末尾时 origin 仍在列表中，下一轮继续从新点扩展
+            active.pop_back();
+        }
+    }
+    return points;
+}
+
+} // namespace
+
+std::vector<Tree> generateRandomTrees(
+    int treeCount, float xMin, float xMax,
+    float zMin, float zMax,
+    float houseXRange, float houseZRange,
+    float minDistance, uint32_t seed) {
 
-        if (!isTooClose) {
-            // 生成随机缩放因子 
-            float randomScale = 1.5f + static_cast<float>(rand()) / (static_cast<float>(RAND_MAX)) * 0.5f;
-            trees.push_back({ glm::vec3(randX, 0.0f, randZ), randomScale });
+    std::vector<Tree> trees;
+    if (treeCount <= 0 || xMax <= xMin || zMax <= zMin) return trees;
+
+    auto start = std::chrono::steady_clock::now();
+    std::mt19937 rng(seed);
+    PlacementDomain domain{ xMin, xMax, zMin, zMax, houseXRange, houseZRange };
+
+    // 采样间距：不小于 minDistance；请求的树远少于区域容量时放大间距，
+    // 填满后随机取 treeCount 个点，使树木均匀分布在整个区域而不是聚集在第一个种子周围。
+    // 填充密度约为 0.73 / r²，取 0.8 倍的目标间距（约 1.15 倍的点数）留出余量
+    float spacing = 0.8f * std::sqrt(domain.usableArea() / (float)treeCount);
+    float radius = std::max(minDistance, spacing);
+    std::vector<glm::vec2> points;
+    if (radius > 0.0f) {
+        points = samplePoissonDisk(domain, radius, rng);
+        // 估计偏高（区域狭长、空洞切割）时缩小间距重采样一次，间距仍不小于 minDistance
+        if ((int)points.size() < treeCount && radius > minDistance) {
+            radius = std::max(minDistance, 0.7f * spacing);
+            points = samplePoissonDisk(domain, radius, rng);
         }
     }
+
+    // 部分 Fisher-Yates 洗牌：随机选出 treeCount 个点
+    size_t placed = std::min(points.size(), (size_t)treeCount);
+    for (size_t i = 0; i < placed; i++) {
+        size_t j = std::uniform_int_distribution<size_t>(i, points.size() - 1)(rng);
+        std::swap(points[i], points[j]);
+    }
+
+    std::uniform_real_distribution<float> scaleDistribution(1.5f, 2.0f); // 随机缩放因子
+    trees.reserve(placed);
+    for (size_t i = 0; i < placed; i++) {
+        trees.push_back({ glm::vec3(points[i].x, 0.0f, points[i].y), scaleDistribution(rng) });
+    }
+
+    double elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "[Tree] Poisson-disk placement: " << placed << " / " << treeCount << " trees, spacing "
+        << radius << ", " << elapsed << " ms" << std::endl;
+    if ((int)placed < treeCount) {
+        std::cout << "[Tree] Only " << placed << " trees fit with minimum distance " << minDistance << std::endl;
+    }
     return trees;
 }
-
@@ -3,17 +3,20 @@
 
 #include <glm/glm.hpp>
 #include <vector>
+#include <cstdint>
 
 struct Tree {
     glm::vec3 position;
     float scale; // 随机缩放因子
 };
 
+// 泊松圆盘采样（Bridson）放置树木：任意两棵树的距离不小于 minDistance，避开房子周围区域。
+// 相同 seed 得到相同结果；区域容纳不下 treeCount 棵时返回能放下的全部树（数量可能少于请求）
 std::vector<Tree> generateRandomTrees(
     int treeCount, float xMin = -12.0f, float xMax = 12.0f,
     float zMin = -20.0f, float zMax = 20.0f,
     float houseXRange = 4.0f, float houseZRange = 4.0f,
-    float minDistance = 2.0f);
+    float minDistance = 2.0f, uint32_t seed = 1);
 
 #endif // TREE_H
 
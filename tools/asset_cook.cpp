@@ -0,0 +1,246 @@
+// 资源烘焙工具：把 objects/ 与 shaders/ 转换为运行时直接使用的格式
+//   纹理（.jpg/.png）-> <源>.dds      BC1/BC3 + 完整 mip 链（TextureCooker）
+//   模型（.obj 等）   -> <源>.meshcache 焊接、索引优化、meshlet 划分（Model::cookMeshCache）
+//   着色器            -> <源>.cooked    展开 #include、去掉注释与空行
+// 按内容哈希增量烘焙：源文件与依赖（.mtl / #include）都未变且产物存在时跳过，结果写入清单
+// 用法：asset_cook [--manifest asset_manifest.txt] [--force] [目录...]（默认 objects shaders）
+#include "core/AssetManifest.h"
+#include "core/TextureCooker.h"
+#include "core/MeshCache.h"
+#include "core/Model.h"
+#include "core/ThreadPool.h"
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include <string>
+#include <unordered_map>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <cctype>
+
+namespace fs = std::filesystem;
+
+static std::string lowerExtension(const fs::path& path) {
+    std::string extension = path.extension().string();
+    std::transform(extension.begin(), extension.end(), extension.begin(),
+        [](unsigned char c) { return (char)std::tolower(c); });
+    return extension;
+}
+
+static bool classify(const fs::path& path, CookedAssetKind& kind) {
+    std::string extension = lowerExtension(path);
+    if (extension == ".jpg" || extension == ".jpeg" || extension == ".png") {
+        kind = CookedAssetKind::Texture;
+    } else if (extension == ".obj" || extension == ".fbx" || extension == ".gltf" || extension == ".glb") {
+        kind = CookedAssetKind::Mesh;
+    } else if (extension == ".vs" || extension == ".fs" || extension == ".gs" || extension == ".glsl"
+        || extension == ".vert" || extension == ".frag") {
+        kind = CookedAssetKind::Shader;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+static std::string outputPath(CookedAssetKind kind, const std::string& source) {
+    switch (kind) {
+    case CookedAssetKind::Texture: return getCookedTexturePath(source);
+    case CookedAssetKind::Mesh: return getMeshCachePath(source);
+    default: return source + ".cooked";
+    }
+}
+
+// 模型依赖：mtllib 引用的材质库（与 ObjLoader 一致，找不到时退回同名 .mtl）
+static std::vector<std::string> findMeshDependencies(const std::string& path) {
+    std::vector<std::string> dependencies;
+    if (lowerExtension(path) != ".obj") return dependencies;
+    std::ifstream file(path);
+    std::string directory = fs::path(path).parent_path().generic_string();
+    std::string line;
+    while (std::getline(file, line)) {
+        if (line.compare(0, 7, "mtllib ") != 0) continue;
+        std::string lib = line.substr(7);
+        while (!lib.empty() && std::isspace((unsigned char)lib.back())) lib.pop_back();
+        std::string libPath = (directory.empty() ? "" : directory + "/") + lib;
+        if (!fs::exists(libPath)) {
+            libPath = (directory.empty() ? "" : directory + "/") + fs::path(path).stem().string() + ".mtl";
+        }
+        if (std::find(dependencies.begin(), dependencies.end(), libPath) == dependencies.end()) {
+            dependencies.push_back(libPath);
+        }
+    }
+    return dependencies;
+}
+
+// 着色器预处理：展开 #include "文件"（相对当前文件），去掉 // 与 /* */ 注释、行尾空白与空行。
+// 去掉注释后源码只剩 ASCII，避免部分驱动在 GBK / UTF-8 注释上编译失败
+static bool preprocessShader(const std::string& path, std::string& out,
+    std::vector<std::string>& dependencies, int depth) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file || depth > 16) {
+        std::cerr << "[AssetCook] Cannot read shader: " << path << std::endl;
+        return false;
+    }
+    std::string directory = fs::path(path).parent_path().generic_string();
+
+    bool inBlockComment = false;
+    std::string line;
+    while (std::getline(file, line)) {
+        std::string code;
+        for (size_t i = 0; i < line.size(); i++) {
+            if (inBlockComment) {
+                if (line.compare(i, 2, "*/") == 0) {
+                    inBlockComment = false;
+                    i++;
+                }
+            } else if (line.compare(i, 2, "/*") == 0) {
+                inBlockComment = true;
+                i++;
+            } else if (line.compare(i, 2, "//") == 0) {
+                break;
+            } else {
+                code += line[i];
+            }
+        }
+        while (!code.empty() && std::isspace((unsigned char)code.back())) code.pop_back();
+        if (code.empty()) continue;
+
+        size_t start = code.find_first_not_of(" \t");
+        if (code.compare(start, 8, "#include") == 0) {
+            size_t open = code.find('"', start);
+            size_t close = (open == std::string::npos) ? open : code.find('"', open + 1);
+            if (close == std::string::npos) {
+                std::cerr << "[AssetCook] Malformed #include in " << path << ": " << code << std::endl;
+                return false;
+            }
+            std::string include = (directory.empty() ? "" : directory + "/") + code.substr(open + 1, close - open - 1);
+            if (std::find(dependencies.begin(), dependencies.end(), include) == dependencies.end()) {
+                dependencies.push_back(include);
+            }
+            if (!preprocessShader(include, out, dependencies, depth + 1)) return false;
+            continue;
+        }
+        out += code;
+        out += '\n';
+    }
+    return true;
+}
+
+static bool cookShader(CookedAsset& asset) {
+    std::string source;
+    asset.dependencies.clear();
+    if (!preprocessShader(asset.source, source, asset.dependencies, 0)) return false;
+    std::ofstream out(asset.output, std::ios::binary | std::ios::trunc);
+    out << source;
+    return (bool)out;
+}
+
+static bool cookAsset(CookedAsset& asset) {
+    switch (asset.kind) {
+    case CookedAssetKind::Texture: {
+        // 产物过期时 cookTexture 会重新烘焙；强制烘焙时先删除旧产物
+        CompressedImage image;
+        return cookTexture(asset.source, true, image);
+    }
+    case CookedAssetKind::Mesh:
+        asset.dependencies = findMeshDependencies(asset.source);
+        return Model::cookMeshCache(asset.source);
+    default:
+        return cookShader(asset);
+    }
+}
+
+int main(int argc, char** argv) {
+    std::string manifestPath = "asset_manifest.txt";
+    std::vector<std::string> roots;
+    bool force = false;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--manifest" && i + 1 < argc) {
+            manifestPath = argv[++i];
+        } else if (arg == "--force") {
+            force = true;
+        } else {
+            roots.push_back(arg);
+        }
+    }
+    if (roots.empty()) roots = { "objects", "shaders" };
+
+    // 收集输入（路径相对当前目录，与运行时的资源路径一致）
+    std::vector<CookedAsset> assets;
+    for (const std::string& root : roots) {
+        std::error_code ec;
+        for (fs::recursive_directory_iterator it(root, ec), end; !ec && it != end; it.increment(ec)) {
+            CookedAssetKind kind;
+            if (!it->is_regular_file(ec) || !classify(it->path(), kind)) continue;
+            CookedAsset asset;
+            asset.kind = kind;
+            asset.source = it->path().generic_string();
+            asset.output = outputPath(kind, asset.source);
+            assets.push_back(asset);
+        }
+        if (ec) {
+            std::cerr << "[AssetCook] Cannot read " << root << ": " << ec.message() << std::endl;
+        }
+    }
+    std::sort(assets.begin(), assets.end(),
+        [](const CookedAsset& a, const CookedAsset& b) { return a.source < b.source; });
+
+    // 上次的清单：依赖列表与输入哈希
+    std::vector<CookedAsset> previousAssets;
+    std::unordered_map<std::string, const CookedAsset*> previous;
+    if (!force && readAssetManifest(manifestPath, previousAssets)) {
+        for (const CookedAsset& asset : previousAssets) {
+            previous[asset.source] = &asset;
+        }
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    std::atomic<size_t> cooked{ 0 }, upToDate{ 0 }, failed{ 0 };
+    std::vector<char> succeeded(assets.size(), 0);
+    getThreadPool().parallelFor(assets.size(), [&](size_t i) {
+        CookedAsset& asset = assets[i];
+        auto it = previous.find(asset.source);
+        if (it != previous.end() && it->second->kind == asset.kind && fs::exists(asset.output)) {
+            asset.dependencies = it->second->dependencies;
+            if (computeCookedInputHash(asset) == it->second->inputHash) {
+                asset.inputHash = it->second->inputHash;
+                succeeded[i] = 1;
+                upToDate++;
+                return;
+            }
+        }
+
+        if (force) {
+            std::error_code ec;
+            fs::remove(asset.output, ec);
+        }
+        if (!cookAsset(asset)) {
+            std::cerr << "[AssetCook] Failed: " << asset.source << std::endl;
+            failed++;
+            return;
+        }
+        asset.inputHash = computeCookedInputHash(asset);
+        succeeded[i] = 1;
+        cooked++;
+        std::cout << "[AssetCook] Cooked " << getCookedAssetKindName(asset.kind) << ": " << asset.output << std::endl;
+    });
+
+    // 清单只记录成功的产物，失败的资源下次重新尝试
+    std::vector<CookedAsset> manifest;
+    for (size_t i = 0; i < assets.size(); i++) {
+        if (succeeded[i]) manifest.push_back(assets[i]);
+    }
+    if (!writeAssetManifest(manifestPath, manifest)) {
+        std::cerr << "[AssetCook] Cannot write manifest: " << manifestPath << std::endl;
+        return 1;
+    }
+
+    double elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "[AssetCook] " << cooked << " cooked, " << upToDate << " up to date, " << failed << " failed in "
+        << elapsed << " ms (" << getThreadPool().size() + 1 << " threads) -> " << manifestPath << std::endl;
+    return failed > 0 ? 1 : 0;
+}
@@ -0,0 +1,81 @@
+// 资源打包工具：把目录 / 文件打成 .sfpak 资源包，包内路径为相对于当前目录的路径
+// 用法：asset_pack <输出.sfpak> <目录或文件>... [--compress none|lz4|zstd] [--level N] [--align N]
+// 例：在源码根目录执行 asset_pack assets.sfpak shaders objects
+#include "core/AssetArchive.h"
+#include <iostream>
+#include <vector>
+#include <string>
+#include <filesystem>
+#include <algorithm>
+#include <cstdlib>
+
+namespace fs = std::filesystem;
+
+// 临时文件与资源包本身不打包
+static bool shouldPack(const fs::path& path) {
+    std::string extension = path.extension().string();
+    return extension != ".sfpak" && extension.rfind(".tmp", 0) != 0;
+}
+
+static void collectInputs(const std::string& root, std::vector<ArchiveInput>& inputs) {
+    std::error_code ec;
+    if (fs::is_regular_file(root, ec)) {
+        inputs.push_back({ fs::path(root).generic_string(), root });
+        return;
+    }
+    for (fs::recursive_directory_iterator it(root, ec), end; !ec && it != end; it.increment(ec)) {
+        if (it->is_regular_file(ec) && shouldPack(it->path())) {
+            std::string path = it->path().generic_string();
+            inputs.push_back({ path, path });
+        }
+    }
+    if (ec) {
+        std::cerr << "Cannot read " << root << ": " << ec.message() << std::endl;
+    }
+}
+
+int main(int argc, char** argv) {
+    std::string output;
+    std::vector<std::string> roots;
+    ArchiveWriteOptions options;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--compress" && i + 1 < argc) {
+            std::string name = argv[++i];
+            if (name == "lz4") options.compression = ArchiveCompression::LZ4;
+            else if (name == "zstd") options.compression = ArchiveCompression::Zstd;
+            else if (name == "none") options.compression = ArchiveCompression::None;
+            else {
+                std::cerr << "Unknown compression: " << name << std::endl;
+                return 1;
+            }
+        } else if (arg == "--level" && i + 1 < argc) {
+            options.level = std::atoi(argv[++i]);
+        } else if (arg == "--align" && i + 1 < argc) {
+            options.alignment = (uint32_t)std::max(16, std::atoi(argv[++i]));
+        } else if (output.empty()) {
+            output = arg;
+        } else {
+            roots.push_back(arg);
+        }
+    }
+    if (output.empty() || roots.empty()) {
+        std::cerr << "Usage: asset_pack <output.sfpak> <dir or file>... [--compress none|lz4|zstd] [--level N] [--align N]" << std::endl;
+        return 1;
+    }
+
+    std::vector<ArchiveInput> inputs;
+    for (const std::string& root : roots) {
+        collectInputs(root, inputs);
+    }
+
+    ArchiveWriteStats stats;
+    if (!writeAssetArchive(output, inputs, options, &stats)) {
+        std::cerr << "Failed to write " << output << std::endl;
+        return 1;
+    }
+    std::cout << "Packed " << stats.entries << " files into " << output << " (" << stats.compressedEntries
+        << " compressed with " << getArchiveCompressionName(options.compression) << "): "
+        << stats.rawBytes / 1024 << " KB -> " << stats.archiveBytes / 1024 << " KB" << std::endl;
+    return 0;
+}
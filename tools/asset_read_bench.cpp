@@ -0,0 +1,192 @@
+// 资源读取基准：比较异步读取器的 io_uring 后端、线程池 pread 后端与逐个 std::ifstream 读取
+// 用法：asset_read_bench [目录] [重复次数] [--archive 资源包.sfpak] [--cold]
+// 每轮把目录下全部文件一次批量提交，报告吞吐量（中位数一轮）与单文件延迟（提交到回调）的 p50 / p99 / 最大值。
+// --cold 在每轮前用 posix_fadvise(DONTNEED) 丢弃这些文件的页缓存，测量冷读取
+#include "core/AsyncFileReader.h"
+#include "core/VirtualFileSystem.h"
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <filesystem>
+#include <cstdlib>
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace fs = std::filesystem;
+using Clock = std::chrono::steady_clock;
+
+struct RunStats {
+    double elapsedMs = 0.0;
+    uint64_t bytes = 0;
+    size_t failed = 0;
+    std::vector<double> latencies; // 每个文件：提交到读取完成（毫秒）
+};
+
+// 丢弃文件的页缓存（需要文件页为干净页，刚读过的资源文件满足）
+static void dropPageCache(const std::vector<std::string>& paths) {
+#ifndef _WIN32
+    for (const std::string& path : paths) {
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) continue;
+        posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+        ::close(fd);
+    }
+#else
+    (void)paths;
+#endif
+}
+
+static RunStats runAsync(const std::vector<std::string>& files) {
+    RunStats stats;
+    stats.latencies.resize(files.size());
+    std::mutex mutex;
+    std::condition_variable done;
+    size_t remaining = files.size();
+
+    auto start = Clock::now();
+    readFilesAsync(files, [&](FileReadResult& result) {
+        double latency = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+        std::lock_guard<std::mutex> lock(mutex);
+        stats.latencies[result.index] = latency;
+        if (result.ok) stats.bytes += result.data.size();
+        else stats.failed++;
+        if (--remaining == 0) done.notify_one();
+    });
+    std::unique_lock<std::mutex> lock(mutex);
+    done.wait(lock, [&]() { return remaining == 0; });
+    stats.elapsedMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    return stats;
+}
+
+// 基线：调用线程上逐个 std::ifstream 读取散文件（资源包条目经 VirtualFile 读取）
+static RunStats runSequential(const std::vector<std::string>& files, bool packed) {
+    RunStats stats;
+    auto start = Clock::now();
+    for (const std::string& path : files) {
+        bool ok = false;
+        if (packed) {
+            VirtualFile file;
+            if (file.open(path)) {
+                std::vector<uint8_t> data(file.data(), file.data() + file.size());
+                stats.bytes += data.size();
+                ok = true;
+            }
+        } else {
+            std::ifstream file(path, std::ios::binary | std::ios::ate);
+            if (file) {
+                std::vector<char> data((size_t)file.tellg());
+                file.seekg(0);
+                ok = data.empty() || (bool)file.read(data.data(), (std::streamsize)data.size());
+                stats.bytes += data.size();
+            }
+        }
+        if (!ok) stats.failed++;
+        stats.latencies.push_back(std::chrono::duration<double, std::milli>(Clock::now() - start).count());
+    }
+    stats.elapsedMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    return stats;
+}
+
+static double percentile(std::vector<double> values, double p) {
+    if (values.empty()) return 0.0;
+    std::sort(values.begin(), values.end());
+    size_t index = std::min(values.size() - 1, (size_t)(p * (double)(values.size() - 1) + 0.5));
+    return values[index];
+}
+
+static void report(const char* name, int runs, const std::function<RunStats()>& run, const std::function<void()>& prepare) {
+    std::vector<double> elapsed, latencies;
+    uint64_t bytes = 0;
+    size_t failed = 0;
+    for (int i = 0; i < runs; i++) {
+        prepare();
+        RunStats stats = run();
+        elapsed.push_back(stats.elapsedMs);
+        latencies.insert(latencies.end(), stats.latencies.begin(), stats.latencies.end());
+        bytes = stats.bytes;
+        failed += stats.failed;
+    }
+    double medianMs = percentile(elapsed, 0.5);
+    double throughput = medianMs > 0.0 ? (double)bytes / (1024.0 * 1024.0) / (medianMs / 1000.0) : 0.0;
+    std::cout << std::left << std::setw(20) << name << std::right << std::fixed << std::setprecision(2)
+        << std::setw(10) << medianMs << " ms" << std::setw(11) << throughput << " MB/s"
+        << "   latency p50 " << std::setw(8) << percentile(latencies, 0.5)
+        << "  p99 " << std::setw(8) << percentile(latencies, 0.99)
+        << "  max " << std::setw(8) << percentile(latencies, 1.0) << " ms";
+    if (failed > 0) std::cout << "   (" << failed << " failed)";
+    std::cout << std::endl;
+}
+
+int main(int argc, char** argv) {
+    std::string directory = "objects";
+    std::string archive;
+    int runs = 5;
+    bool cold = false;
+    int positional = 0;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--archive" && i + 1 < argc) {
+            archive = argv[++i];
+        } else if (arg == "--cold") {
+            cold = true;
+        } else if (positional++ == 0) {
+            directory = arg;
+        } else {
+            runs = std::max(1, std::atoi(arg.c_str()));
+        }
+    }
+
+    std::vector<std::string> files;
+    uint64_t totalBytes = 0;
+    std::error_code ec;
+    for (fs::recursive_directory_iterator it(directory, ec), end; !ec && it != end; it.increment(ec)) {
+        if (!it->is_regular_file(ec)) continue;
+        files.push_back(it->path().generic_string());
+        totalBytes += it->file_size(ec);
+    }
+    if (files.empty()) {
+        std::cerr << "No files found in " << directory << std::endl;
+        return 1;
+    }
+    std::sort(files.begin(), files.end());
+
+    // 资源包中的条目从包文件按偏移读取；冷读取时丢弃的是包文件的缓存
+    std::vector<std::string> cacheFiles = files;
+    if (!archive.empty()) {
+        if (!mountArchive(archive)) return 1;
+        cacheFiles = { archive };
+    }
+    std::function<void()> prepare = [&]() {
+        if (cold) dropPageCache(cacheFiles);
+    };
+
+    std::cout << files.size() << " files, " << std::fixed << std::setprecision(1) << totalBytes / (1024.0 * 1024.0)
+        << " MB from " << (archive.empty() ? directory : archive) << ", " << runs << " runs"
+        << (cold ? ", cold page cache" : ", warm page cache") << std::endl;
+
+    // 预热：第一轮建立页缓存（热读取）并创建线程池
+    runSequential(files, !archive.empty());
+
+    report("ifstream sequential", runs, [&]() { return runSequential(files, !archive.empty()); }, prepare);
+    setFileReaderBackend(FileReaderBackend::ThreadPool);
+    report("thread pool pread", runs, [&]() { return runAsync(files); }, prepare);
+    if (setFileReaderBackend(FileReaderBackend::IoUring)) {
+        report("io_uring", runs, [&]() { return runAsync(files); }, prepare);
+    } else {
+        std::cout << "io_uring            unavailable on this system" << std::endl;
+    }
+
+    shutdownFileReader();
+    unmountArchives();
+    return 0;
+}
@@ -0,0 +1,110 @@
+// JPEG 解码基准：比较 stb_image 与当前构建的解码后端（FOREST_USE_LIBJPEG_TURBO）
+// 用法：image_decode_bench [图像目录] [重复次数]
+// 缩小解码：stb_image 解码全尺寸后 2x2 降采样，libjpeg-turbo 在 DCT 域直接输出小图
+// 两条路径都从同一块映射内存解码（文件在计时前映射），只比较解码本身
+#define STB_IMAGE_IMPLEMENTATION
+#include "../include/stb/stb_image.h"
+#include "core/ImageDecoder.h"
+#include "core/MipGenerator.h"
+#include "core/VirtualFileSystem.h"
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <filesystem>
+#include <cstdlib>
+
+namespace fs = std::filesystem;
+
+// 运行 runs 次，返回耗时中位数（毫秒）
+static double measure(int runs, const std::function<bool()>& task) {
+    std::vector<double> times;
+    for (int i = 0; i < runs; i++) {
+        auto start = std::chrono::steady_clock::now();
+        if (!task()) return -1.0;
+        times.push_back(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+    }
+    std::sort(times.begin(), times.end());
+    return times[times.size() / 2];
+}
+
+// stb_image 基线：解码 RGBA 后逐级降采样（第一级直接从解码结果读取）
+static bool decodeWithStb(const VirtualFile& file, int scaleShift) {
+    int width, height, channels;
+    unsigned char* pixels = stbi_load_from_memory(file.data(), (int)file.size(), &width, &height, &channels, 4);
+    if (!pixels) return false;
+    std::vector<unsigned char> current, next;
+    const unsigned char* source = pixels;
+    for (int i = 0; i < scaleShift; i++) {
+        downsampleImage(source, width, height, 4, true, next);
+        current.swap(next);
+        source = current.data();
+        width = std::max(1, width / 2);
+        height = std::max(1, height / 2);
+    }
+    stbi_image_free(pixels);
+    return true;
+}
+
+static bool decodeWithBackend(const VirtualFile& file, int scaleShift) {
+    int width, height, channels;
+    unsigned char* pixels = loadImageFromMemory(file.data(), file.size(), &width, &height, &channels, 4, scaleShift);
+    freeImage(pixels);
+    return pixels != nullptr;
+}
+
+int main(int argc, char** argv) {
+    std::string directory = argc > 1 ? argv[1] : "objects";
+    int runs = argc > 2 ? std::max(1, std::atoi(argv[2])) : 5;
+
+    std::vector<std::string> files;
+    std::error_code ec;
+    for (const fs::directory_entry& entry : fs::directory_iterator(directory, ec)) {
+        std::string extension = entry.path().extension().string();
+        std::transform(extension.begin(), extension.end(), extension.begin(),
+            [](unsigned char c) { return (char)std::tolower(c); });
+        if (extension == ".jpg" || extension == ".jpeg") files.push_back(entry.path().string());
+    }
+    std::sort(files.begin(), files.end());
+    if (files.empty()) {
+        std::cerr << "No JPEG files found in " << directory << std::endl;
+        return 1;
+    }
+
+    // 当前构建没有 libjpeg-turbo 时两列都是 stb_image，差异只是测量噪声，不输出加速比
+    bool sameDecoder = std::string(getJpegDecoderName()) == "stb_image";
+    std::cout << "JPEG decoder backend: " << getJpegDecoderName() << ", " << runs << " runs, median ms" << std::endl;
+    const char* scaleNames[] = { "full", "half", "quarter" };
+    for (int scaleShift = 0; scaleShift < 3; scaleShift++) {
+        double stbTotal = 0.0, backendTotal = 0.0;
+        std::cout << "[" << scaleNames[scaleShift] << "]" << std::endl;
+        for (const std::string& file : files) {
+            VirtualFile mapped;
+            double stb = -1.0, backend = -1.0;
+            if (mapped.open(file)) {
+                stb = measure(runs, [&]() { return decodeWithStb(mapped, scaleShift); });
+                backend = measure(runs, [&]() { return decodeWithBackend(mapped, scaleShift); });
+            }
+            if (stb < 0.0 || backend < 0.0) {
+                std::cout << "  " << fs::path(file).filename().string() << ": decode failed" << std::endl;
+                continue;
+            }
+            stbTotal += stb;
+            backendTotal += backend;
+            std::cout << "  " << std::left << std::setw(20) << fs::path(file).filename().string() << std::right
+                << std::fixed << std::setprecision(2) << " stb_image " << std::setw(8) << stb
+                << "  " << getJpegDecoderName() << " " << std::setw(8) << backend << std::endl;
+        }
+        std::cout << "  total: stb_image " << stbTotal << " ms, " << getJpegDecoderName() << " " << backendTotal << " ms";
+        if (sameDecoder) {
+            std::cout << " (same decoder; build with FOREST_USE_LIBJPEG_TURBO to compare)";
+        } else if (backendTotal > 0.0) {
+            std::cout << " (" << stbTotal / backendTotal << "x)";
+        }
+        std::cout << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,70 @@
+// OBJ 加载基准：比较内置多线程加载器与 Assimp 的导入耗时
+// 用法：obj_loader_bench [模型路径] [重复次数]
+#include "core/ObjLoader.h"
+#include <iostream>
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <thread>
+#include <cstdlib>
+
+#ifdef ASSIMP_AVAILABLE
+#include <assimp/Importer.hpp>
+#include <assimp/scene.h>
+#include <assimp/postprocess.h>
+#endif
+
+// 运行 runs 次，返回耗时中位数（毫秒）
+static double measure(int runs, const std::function<bool()>& task) {
+    std::vector<double> times;
+    for (int i = 0; i < runs; i++) {
+        auto start = std::chrono::steady_clock::now();
+        if (!task()) return -1.0;
+        times.push_back(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+    }
+    std::sort(times.begin(), times.end());
+    return times[times.size() / 2];
+}
+
+int main(int argc, char** argv) {
+    std::string path = argc > 1 ? argv[1] : "objects/tree_old.obj";
+    int runs = argc > 2 ? std::max(1, std::atoi(argv[2])) : 10;
+
+    // 不计时的首次加载：输出缺失材质库等警告；计时循环静默加载，不把 stderr 输出计入耗时
+    ObjScene scene;
+    if (!loadObj(path, scene)) {
+        std::cerr << "Failed to load " << path << std::endl;
+        return 1;
+    }
+    size_t vertexCount = 0;
+    for (const MeshData& mesh : scene.meshes) vertexCount += mesh.vertices.size();
+    std::cout << path << ": " << scene.stats.positions << " positions, " << scene.stats.faces << " faces, "
+        << scene.stats.triangles << " triangles, " << vertexCount << " unique vertices, "
+        << scene.materials.size() << " materials" << std::endl;
+
+    unsigned int hardwareThreads = std::max(1u, std::thread::hardware_concurrency());
+    double single = measure(runs, [&]() { ObjScene s; return loadObj(path, s, 1, true); });
+    double parallel = measure(runs, [&]() { ObjScene s; return loadObj(path, s, hardwareThreads, true); });
+    std::cout << "  native (1 thread):   " << single << " ms" << std::endl;
+    std::cout << "  native (" << hardwareThreads << " threads):  " << parallel << " ms" << std::endl;
+
+#ifdef ASSIMP_AVAILABLE
+    // 与 Model 的 Assimp 导入使用相同的后处理
+    double assimp = measure(runs, [&]() {
+        Assimp::Importer importer;
+        const aiScene* s = importer.ReadFile(path,
+            aiProcess_Triangulate | aiProcess_GenSmoothNormals | aiProcess_FlipUVs);
+        return s != nullptr && s->mRootNode != nullptr;
+    });
+    std::cout << "  assimp:              " << assimp << " ms";
+    if (assimp > 0.0 && parallel > 0.0) {
+        std::cout << " (native is " << assimp / parallel << "x faster)";
+    }
+    std::cout << std::endl;
+#else
+    std::cout << "  assimp:              not available in this build" << std::endl;
+#endif
+    return 0;
+}